@@ -68,12 +68,16 @@ typedef uint32_t color_ffxt;
 #define FIXED_BITS_14(v)     (((v) * 65541) >> 14)
 #define FIXED_BITS_15(v)     (((v) * 65539) >> 15)
 
-// Black with base-2 fraction opacities. These can be highly optimized
-// for alpha-blending using only bitwise operators.
+// Black and white with base-2 fraction opacities. These (and those with
+// an opacity of 4 or 28) are alpha-blended using only bitwise operators.
 #define RGBA_DARKER25        (0x18000000)
 #define RGBA_DARKER50        (0x10000000)
 #define RGBA_DARKER75        (0x08000000)
 
+#define RGBA_LIGHTER25       (0x18ffffff)
+#define RGBA_LIGHTER50       (0x10ffffff)
+#define RGBA_LIGHTER75       (0x08ffffff)
+
 #define MAX_VAL              (0x3f)
 #define MAX_SAT              (0x3f)
 
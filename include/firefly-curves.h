@@ -7,6 +7,8 @@ extern "C" {
 #endif /* __cplusplus */
 
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "firefly-fixed.h"
@@ -60,6 +62,77 @@ fixed_ffxt FfxCurveEaseOutBounce(fixed_ffxt t);
 fixed_ffxt FfxCurveEaseInOutBounce(fixed_ffxt t);
 
 
+/**
+ *  Curve tables
+ *
+ *  A curve sampled at [[FFX_CURVE_TABLE_SIZE]] + 1 evenly spaced
+ *  points, evaluated with linear interpolation. This is far cheaper
+ *  than the curves which use powfx, sinfx or cosfx, with an error
+ *  under 1/1000 for the continuous built-in curves.
+ */
+
+#define FFX_CURVE_TABLE_BITS    (8)
+#define FFX_CURVE_TABLE_SIZE    (1 << FFX_CURVE_TABLE_BITS)
+
+typedef struct FfxCurveTable {
+    FfxCurveFunc curve;
+    fixed_ffxt values[FFX_CURVE_TABLE_SIZE + 1];
+} FfxCurveTable;
+
+/**
+ *  Populate %%table%% by sampling %%curve%%.
+ */
+void ffx_curve_initTable(FfxCurveTable *table, FfxCurveFunc curve);
+
+/**
+ *  Evaluate the curve sampled by %%table%% at %%t%%, which is clamped
+ *  to [0, 1].
+ */
+fixed_ffxt ffx_curve_evalTable(const FfxCurveTable *table, fixed_ffxt t);
+
+/**
+ *  A curve which requires additional state, such as its control points,
+ *  passed as %%context%%.
+ */
+typedef fixed_ffxt (*FfxCurveSampleFunc)(fixed_ffxt t, void *context);
+
+/**
+ *  Populate %%table%% by sampling %%sampleFunc%% with %%context%%, which
+ *  is not retained, so the table may be used as a self-contained curve.
+ *
+ *  The table curve is NULL.
+ */
+void ffx_curve_sampleTable(FfxCurveTable *table, FfxCurveSampleFunc sampleFunc,
+  void *context);
+
+/**
+ *  Populate %%table%% with the CSS-style ``cubic-bezier(x1, y1, x2, y2)``
+ *  easing, where the curve runs from (0, 0) to (1, 1).
+ *
+ *  Returns false (leaving %%table%% unchanged) if %%x1%% or %%x2%% is
+ *  outside [0, 1].
+ */
+bool ffx_curve_initBezier(FfxCurveTable *table, fixed_ffxt x1, fixed_ffxt y1,
+  fixed_ffxt x2, fixed_ffxt y2);
+
+typedef struct FfxCurvePoint {
+    fixed_ffxt t;
+    fixed_ffxt value;
+} FfxCurvePoint;
+
+/**
+ *  Populate %%table%% with the piecewise-linear curve through the
+ *  %%count%% %%points%%, which must be ordered by t. Before the first
+ *  point and after the last point the curve is flat. Two points with
+ *  the same t form a step.
+ *
+ *  Returns false (leaving %%table%% unchanged) if there are no points
+ *  or they are out of order.
+ */
+bool ffx_curve_initPiecewise(FfxCurveTable *table, const FfxCurvePoint *points,
+  size_t count);
+
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
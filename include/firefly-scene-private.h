@@ -20,8 +20,10 @@ typedef bool (*FfxNodeWalkFunc)(FfxNode node, FfxNodeVisitFunc enterFunc,
 
 typedef void (*FfxNodeSequenceFunc)(FfxNode node, FfxPoint worldPos);
 
+// The %%frameBuffer%% has %%stride%% pixels per row and holds the
+// viewport of the screen at %%origin%% with %%size%%
 typedef void (*FfxNodeRenderFunc)(void *render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 
 typedef void (*FfxNodeDumpFunc)(FfxNode node, int indent);
 
@@ -105,9 +107,46 @@ FfxNode ffx_sceneNode_getNextSibling(FfxNode node);
 //////////////////////////////
 // Sequencing
 
-// Used during sequencing to request rendering with the returned state.
+/**
+ *  Used during sequencing to request rendering with the returned state.
+ *
+ *  Renders may be re-used by copying in later sequences, so the state
+ *  must not contain pointers into itself.
+ */
 void* ffx_scene_createRender(FfxNode node, size_t stateSize);
 
+/**
+ *  Set the screen region a %%render%% (returned from createRender) may
+ *  draw to, used to compute the damage between sequences.
+ *
+ *  By default, a render covers the entire screen.
+ */
+void ffx_scene_setRenderBounds(void *render, FfxPoint origin, FfxSize size);
+
+/**
+ *  Mark a %%render%% as drawing every pixel within its bounds opaquely,
+ *  allowing any render beneath it to be skipped.
+ */
+void ffx_scene_setRenderOpaque(void *render, bool opaque);
+
+/**
+ *  Used during rendering to copy %%length%% bytes from %%src%% to the
+ *  frame buffer at %%dst%%, using the blitFunc of %%scene%% (if any) for
+ *  the aligned span.
+ */
+void ffx_scene_blit(FfxScene scene, void *dst, const void *src,
+  size_t length);
+
+/**
+ *  Marks %%node%% and its ancestors as changed, so it is sequenced again
+ *  on the next sequence. Otherwise its renders from the previous sequence
+ *  are re-used.
+ *
+ *  Custom Nodes must call this whenever any state that affects
+ *  sequencing changes.
+ */
+void ffx_sceneNode_setDirty(FfxNode node);
+
 
 //////////////////////////////
 // Animations
@@ -151,6 +190,52 @@ bool ffx_sceneNode_createSizeAction(FfxNode node, FfxSize s0, FfxSize s1,
   FfxNodeActionSetSizeFunc setSizeFunc);
 
 
+/**
+ *  Keyframe tracks
+ *
+ *  A track moves through each keyframe value in turn, reaching it at
+ *  %%time%% (where 0 is the start and FM_1 the end of the animation)
+ *  using %%curve%% from the previous keyframe (NULL for linear). The
+ *  keyframes must be ordered by time and are copied into the action.
+ *
+ *  Before the first keyframe and after the last keyframe the value is
+ *  held. Combined with the animation repeat and yoyo, a looping effect
+ *  needs no further allocations once started.
+ */
+
+typedef struct FfxColorKeyframe {
+    fixed_ffxt time;
+    FfxCurveFunc curve;
+    color_ffxt value;
+} FfxColorKeyframe;
+
+bool ffx_sceneNode_createColorTrack(FfxNode node,
+  const FfxColorKeyframe *frames, size_t count,
+  FfxNodeActionSetColorFunc setColorFunc);
+
+
+typedef struct FfxPointKeyframe {
+    fixed_ffxt time;
+    FfxCurveFunc curve;
+    FfxPoint value;
+} FfxPointKeyframe;
+
+bool ffx_sceneNode_createPointTrack(FfxNode node,
+  const FfxPointKeyframe *frames, size_t count,
+  FfxNodeActionSetPointFunc setPointFunc);
+
+
+typedef struct FfxSizeKeyframe {
+    fixed_ffxt time;
+    FfxCurveFunc curve;
+    FfxSize value;
+} FfxSizeKeyframe;
+
+bool ffx_sceneNode_createSizeTrack(FfxNode node,
+  const FfxSizeKeyframe *frames, size_t count,
+  FfxNodeActionSetSizeFunc setSizeFunc);
+
+
 //////////////////////////////
 // Debugging
 
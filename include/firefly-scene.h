@@ -42,6 +42,15 @@ typedef struct FfxSize {
 } FfxSize;
 
 
+/**
+ *  Rectangle object. A rectangle with a width of 0 is empty.
+ */
+typedef struct FfxRect {
+    FfxPoint origin;
+    FfxSize size;
+} FfxRect;
+
+
 // Font enum definition
 // [ 1 bit: isBold ] [ 1 bit: reserved ] [ 6 bits: size ]
 
@@ -181,6 +190,9 @@ typedef enum FfxSceneActionStop {
 typedef void (*FfxNodeAnimationCompletionFunc)(FfxNode node,
   FfxSceneActionStop stopType, void *arg);
 
+// Repeat an animation until it is stopped
+#define FFX_ANIMATION_REPEAT_FOREVER   (0xffffffff)
+
 /**
  *  Node animation configuration, which can be set in the
  *  [[FfxSceneAnimationSetupFunc]] function
@@ -189,6 +201,16 @@ typedef struct FfxNodeAnimation {
     uint32_t delay;                             // Default: 0
     uint32_t duration;                          // Default: 0
     FfxCurveFunc curve;                         // Default: Linear
+
+    // A compiled curve (see ffx_curve_initBezier), used instead of the
+    // curve; it must remain valid until the animation completes
+    const FfxCurveTable *curveTable;            // Default: NULL
+
+    // The number of additional times to run the animation; if yoyo,
+    // every other run is in reverse
+    uint32_t repeat;                            // Default: 0
+    bool yoyo;                                  // Default: false
+
     FfxNodeAnimationCompletionFunc onComplete;  // Default: NULL
     void* arg;                                  // Default: NULL
 } FfxNodeAnimation;
@@ -215,6 +237,39 @@ typedef void (*FfxSceneAnimationDispatchFunc)(void *setupArg,
   FfxNodeAnimationCompletionFunc callFunc, FfxNode node,
   FfxSceneActionStop stopType, void *arg, void *initArg);
 
+/**
+ *  A completed animation, whose %%callFunc%% should be called with the
+ *  %%node%%, %%stopType%% and %%arg%%. The %%setupArg%% is the value
+ *  returned by the [[FfxSceneAnimationSetupFunc]], if any.
+ */
+typedef struct FfxSceneCompletion {
+    FfxNodeAnimationCompletionFunc callFunc;
+    FfxNode node;
+    FfxSceneActionStop stopType;
+    void *arg;
+    void *setupArg;
+} FfxSceneCompletion;
+
+/**
+ *  Called once at the end of a sequence with all the %%count%%
+ *  %%completions%% from that sequence, which are only valid until
+ *  it returns.
+ */
+typedef void (*FfxSceneCompletionBatchFunc)(
+  const FfxSceneCompletion *completions, size_t count, void *initArg);
+
+/**
+ *  Clock function, returning the current time in microseconds.
+ */
+typedef int64_t (*FfxSceneClockFunc)(void *initArg);
+
+/**
+ *  Copy function, copying %%length%% bytes from %%src%% to %%dst%%,
+ *  which do not overlap. It must be complete before returning.
+ */
+typedef void (*FfxSceneBlitFunc)(void *dst, const void *src, size_t length,
+  void *initArg);
+
 typedef bool (*FfxSceneAnimationQueueFunc)(void *animation, void *initArg);
 typedef void* (*FfxSceneAnimationDequeueFunc)(void *initArg);
 
@@ -229,6 +284,43 @@ typedef struct FfxSceneConfig {
     FfxSceneAnimationDequeueFunc dequeueFunc;
 
     void *initArg;
+
+    // The size of each slab carved up by the node, action and animation
+    // pool; if 0, those are allocated directly with allocFunc
+    size_t poolSlabSize;                        // Default: 0
+
+    // The display dimensions
+    uint16_t width;                             // Default: 240
+    uint16_t height;                            // Default: 240
+
+    // The height of the fragments passed to ffx_scene_render; renders
+    // are binned into bands of this height
+    uint16_t fragmentHeight;                    // Default: 24
+
+    // The number of pixels per row of the fragments
+    uint16_t stride;                            // Default: width
+
+    // Evaluate animation curves using lazily sampled tables (see
+    // FfxCurveTable); curves must depend only on their input
+    bool curveTables;                           // Default: false
+
+    // The clock used by ffx_scene_sequence
+    FfxSceneClockFunc clockFunc;                // Default: FreeRTOS tick
+
+    // Buffer animation completions, instead of calling the dispatchFunc
+    // (or onComplete) for each, handing them to batchFunc at the end of
+    // each sequence or, if pollCompletions (and there is no batchFunc),
+    // to ffx_scene_pollCompletions
+    FfxSceneCompletionBatchFunc batchFunc;      // Default: NULL
+    bool pollCompletions;                       // Default: false
+
+    // Copies the rows of opaque images (e.g. with a DMA engine); only
+    // called with the src, dst and length aligned to blitAlign (a power
+    // of 2), with any unaligned bytes copied by memcpy. Rows whose pixels
+    // are misaligned with the fragment (e.g. since the image header is 6
+    // bytes) are copied entirely by memcpy.
+    FfxSceneBlitFunc blitFunc;                  // Default: NULL (memcpy)
+    uint8_t blitAlign;                          // Default: 4
 } FfxSceneConfig;
 
 /**
@@ -242,13 +334,45 @@ FfxScene ffx_scene_init(FfxSceneAllocFunc allocFunc,
   FfxSceneAnimationDispatchFunc dispatchFunc,
   void *initArg);
 
+/**
+ *  Allocate and initialize a new Scene Graph using %%config%%.
+ *
+ *  If the %%config%% has a non-zero **poolSlabSize**, nodes, actions
+ *  and animations are served from per-scene size-class pools, which
+ *  grow a slab at a time and recycle freed entries, avoiding heap
+ *  fragmentation on animation-heavy screens. The pools are owned by
+ *  the sequencing task (the creating task until the first sequence)
+ *  and take no locks; allocations on other tasks use allocFunc and
+ *  entries freed on other tasks are returned lock-free. Sequencing
+ *  should not move between tasks while others allocate.
+ */
+FfxScene ffx_scene_initConfig(const FfxSceneConfig *config);
+
 /**
  *  Free %%scene%%.
  */
 void ffx_scene_free(FfxScene scene);
 
+/**
+ *  Get the display dimensions of %%scene%%.
+ */
+FfxSize ffx_scene_getSize(FfxScene scene);
+
+/**
+ *  Find an anchor with %%tag%% in the scene graph, in constant time.
+ *
+ *  If multiple anchors share %%tag%%, which is returned is unspecified;
+ *  see [[ffx_scene_findAnchors]].
+ */
 FfxNode ffx_scene_findAnchor(FfxScene scene, FfxNodeTag tag);
 
+/**
+ *  Copy up to %%count%% anchors with %%tag%% in the scene graph into
+ *  %%anchors%%, returning the number of anchors copied.
+ */
+size_t ffx_scene_findAnchors(FfxScene scene, FfxNodeTag tag,
+  FfxNode *anchors, size_t count);
+
 bool ffx_scene_walk(FfxScene scene, FfxNodeVisitFunc enterFunc,
   FfxNodeVisitFunc exitFunc, void *arg);
 
@@ -261,16 +385,100 @@ void ffx_scene_dumpStats(FfxScene scene);
 
 /**
  *  Create a point-in-time renderable snapshot of %%scene%%.
+ *
+ *  Returns false if the rendered output is unchanged, in which case the
+ *  previously rendered frame is still current and rendering it again
+ *  can be skipped. If no node changed, no new snapshot is created.
+ */
+bool ffx_scene_sequence(FfxScene scene);
+
+/**
+ *  Create a point-in-time renderable snapshot of %%scene%%, as of the
+ *  clock time %%now%% (in microseconds) rather than the scene clock.
+ *
+ *  This allows animations to be stepped deterministically, for example
+ *  at exact frame intervals. The times passed should not decrease.
+ */
+bool ffx_scene_sequenceAt(FfxScene scene, int64_t now);
+
+/**
+ *  Get the clock time (in microseconds) the next sequence of %%scene%%
+ *  may change its output at, such as the end of an animation delay, so
+ *  the display can sleep until then. This is the time of the last
+ *  sequence if any animations are running or changes are pending.
+ *
+ *  Returns false if there is no such time, in which case only a
+ *  change to the scene (which the caller must signal) requires a
+ *  sequence.
+ */
+bool ffx_scene_getDeadline(FfxScene scene, int64_t *deadline);
+
+/**
+ *  Copy up to %%count%% buffered animation completions (oldest first)
+ *  of %%scene%% into %%completions%%, returning the number copied. This
+ *  may be called from any task, if the scene was configured with
+ *  **pollCompletions**.
+ *
+ *  The caller is responsible for calling each completion's callFunc.
+ *  Its node may have been removed since the animation completed.
  */
-void ffx_scene_sequence(FfxScene scene);
+size_t ffx_scene_pollCompletions(FfxScene scene,
+  FfxSceneCompletion *completions, size_t count);
+
+/**
+ *  Set the rate animations run at relative to the clock, where FM_1 is
+ *  real-time, FM_1_2 is half speed and 0 pauses all animations.
+ */
+void ffx_scene_setTimeScale(FfxScene scene, fixed_ffxt timeScale);
+
+fixed_ffxt ffx_scene_getTimeScale(FfxScene scene);
 
 /**
  *  Render the most recent snapshot of %%scene%% for the %%fragment%%
  *  within the viewport given by %%origin%% and %%size%%.
+ *
+ *  If the render pass uses [[ffx_scene_acquireRender]], this renders
+ *  the acquired snapshot instead.
  */
 void ffx_scene_render(FfxScene scene, uint16_t *fragment, FfxPoint origin,
   FfxSize size);
 
+/**
+ *  Acquire the most recently sequenced snapshot of %%scene%% for the
+ *  render pass, returning the index of the render list in use.
+ *
+ *  This should be called once before rendering all the fragments of
+ *  a frame, which allows [[ffx_scene_sequence]] to run concurrently
+ *  (e.g. on another core) as the render lists are triple-buffered. If
+ *  no new snapshot was published, the previous one remains in use.
+ *
+ *  Once called, snapshots are only used by [[ffx_scene_render]] after
+ *  being acquired; otherwise each sequence is used immediately.
+ */
+uint32_t ffx_scene_acquireRender(FfxScene scene);
+
+/**
+ *  Get the index of the render list in use by the render pass.
+ */
+uint32_t ffx_scene_getRenderIndex(FfxScene scene);
+
+/**
+ *  Get the bounds of all regions of the snapshot in use by the render
+ *  pass which changed since the snapshot rendered before it. If nothing
+ *  changed, the width is 0.
+ *
+ *  Only the fragments which intersect the damage need to be rendered
+ *  and sent to the display.
+ */
+FfxRect ffx_scene_getDamage(FfxScene scene);
+
+/**
+ *  Copy up to %%count%% damaged regions (see [[ffx_scene_getDamage]])
+ *  into %%rects%%, returning the number of regions copied.
+ */
+size_t ffx_scene_getDamageRects(FfxScene scene, FfxRect *rects,
+  size_t count);
+
 /**
  *  Get the root node of %%scene%%.
  */
@@ -311,8 +519,19 @@ void ffx_sceneNode_offsetPosition(FfxNode node, FfxPoint offset);
 bool ffx_sceneNode_getHidden(FfxNode node);
 void ffx_sceneNode_setHidden(FfxNode node, bool hidden);
 
+/**
+ *  Find an anchor with %%tag%% within the subtree of %%node%% (including
+ *  %%node%%).
+ */
 FfxNode ffx_sceneNode_findAnchor(FfxNode node, FfxNodeTag tag);
 
+/**
+ *  Copy up to %%count%% anchors with %%tag%% within the subtree of
+ *  %%node%% into %%anchors%%, returning the number of anchors copied.
+ */
+size_t ffx_sceneNode_findAnchors(FfxNode node, FfxNodeTag tag,
+  FfxNode *anchors, size_t count);
+
 bool ffx_sceneNode_walk(FfxNode scene, FfxNodeVisitFunc enterFunc,
   FfxNodeVisitFunc exitFunc, void *arg);
 
@@ -343,10 +562,27 @@ typedef void (*FfxNodeAnimationSetupFunc)(FfxNode node,
 
 /**
  *  Animate %%node%% with the %%setupFunc%% and %%arg%%.
+ *
+ *  A property already being animated is taken over by the new
+ *  animation, starting from its current value. If the new animation
+ *  has a delay, the property holds that value until the delay ends.
  */
 void ffx_sceneNode_animate(FfxNode node, FfxNodeAnimationSetupFunc setupFunc,
   void *arg);
 
+/**
+ *  Animate each child of the group %%node%% with the %%setupFunc%% and
+ *  %%arg%%, with each child starting %%stagger%% milliseconds after the
+ *  previous one.
+ *
+ *  All the children share a single animation (and its configuration)
+ *  on %%node%%, which completes once the last child finishes. Stopping
+ *  or advancing the animations of %%node%% affects every child, while
+ *  stopping or advancing those of a child only affects that child.
+ */
+void ffx_sceneGroup_animateChildren(FfxNode node, uint32_t stagger,
+  FfxNodeAnimationSetupFunc setupFunc, void *arg);
+
 
 void ffx_sceneNode_runAnimation(FfxNode node,
   FfxNodeAnimationSetupFunc setupFunc, void *arg, uint32_t delay,
@@ -363,7 +599,8 @@ void ffx_sceneNode_animatePosition(FfxNode node, FfxPoint position,
 
 
 /**
- *  Returns true if %%node%% is running any animations.
+ *  Returns the number of animations running on %%node%%, so a non-zero
+ *  value indicates it is animating.
  */
 uint32_t ffx_sceneNode_isAnimating(FfxNode node);
 
@@ -377,6 +614,22 @@ void ffx_sceneNode_advanceAnimations(FfxNode node, uint32_t advance);
  */
 void ffx_sceneNode_stopAnimations(FfxNode node, bool completeAnimations);
 
+/**
+ *  Defer submitting the animations (including stop and advance requests)
+ *  created by the calling task until the matching [[ffx_scene_endBatch]],
+ *  which submits them all with a single atomic operation, so they start
+ *  on the same sequence.
+ *
+ *  Batches may be nested. Only one task may batch at a time; any other
+ *  task submits its animations immediately.
+ */
+void ffx_scene_beginBatch(FfxScene scene);
+
+/**
+ *  End the current batch (see [[ffx_scene_beginBatch]]).
+ */
+void ffx_scene_endBatch(FfxScene scene);
+
 
 ///////////////////////////////
 // Fill
@@ -0,0 +1,267 @@
+#ifndef __FIREFLY_INTERNAL_BLEND_H__
+#define __FIREFLY_INTERNAL_BLEND_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "firefly-color.h"
+
+
+/**
+ *  RGB565 blending, SIMD-within-a-register
+ *
+ *  A pixel is spread across a 32-bit word (green in the upper half) so
+ *  each channel has enough headroom to be scaled by an alpha in the
+ *  range [0, MAX_OPACITY] without overflowing into its neighbour. All
+ *  three channels are then blended with one multiply per term:
+ *
+ *    result = (fg * alpha + bg * (MAX_OPACITY - alpha)) >> 5
+ *
+ *  which is exact (i.e. matches blending each channel separately with
+ *  the same formula).
+ *
+ *  Per-opacity lookup tables of the channel products (33 levels, 16.5kb)
+ *  were slower than the single multiply, so only per-pixel alpha (such
+ *  as the 4-bit image alpha) is quantized through a table, per render.
+ */
+
+#define BLEND_MASK        (0x07e0f81f)
+
+static inline __attribute__((always_inline)) uint32_t ffx_blend_spread(
+  uint32_t pixel) {
+    return (pixel | (pixel << 16)) & BLEND_MASK;
+}
+
+static inline __attribute__((always_inline)) uint16_t ffx_blend_pack(
+  uint32_t word) {
+    word &= BLEND_MASK;
+    return word | (word >> 16);
+}
+
+/**
+ *  Premultiply the %%fg%% pixel by %%alpha%%, for blending a solid color
+ *  over many pixels.
+ */
+static inline __attribute__((always_inline)) uint32_t ffx_blend_premultiply(
+  uint16_t fg, uint32_t alpha) {
+    return ffx_blend_spread(fg) * alpha;
+}
+
+/**
+ *  Blend the premultiplied %%fgpm%% with %%alpha%% over the %%bg%% pixel.
+ */
+static inline __attribute__((always_inline)) uint16_t ffx_blend_premultiplied(
+  uint32_t fgpm, uint16_t bg, uint32_t alpha) {
+    return ffx_blend_pack((fgpm + ffx_blend_spread(bg) *
+      (MAX_OPACITY - alpha)) >> 5);
+}
+
+/**
+ *  Blend the %%fg%% pixel with %%alpha%% over the %%bg%% pixel.
+ */
+static inline __attribute__((always_inline)) uint16_t ffx_blend(uint16_t fg,
+  uint16_t bg, uint32_t alpha) {
+    return ffx_blend_premultiplied(ffx_blend_premultiply(fg, alpha), bg,
+      alpha);
+}
+
+/**
+ *  Blend the premultiplied %%fgpm%% with %%alpha%% over the %%count%%
+ *  pixels at %%output%%.
+ *
+ *  Only the memory accesses are paired (a 32-bit load and store per two
+ *  pixels); each pixel is still blended on its own. A spread pixel
+ *  needs the whole 32-bit word for its headroom, so two pixels in one
+ *  word (e.g. 0x07e0f81f split into lanes) would overflow one channel
+ *  into the next. Two pixels per 64-bit word would fit, but the ESP32
+ *  has no 64-bit multiply, so that only helps on a host.
+ */
+static inline __attribute__((always_inline)) void ffx_blend_row(
+  uint16_t *output, int32_t count, uint32_t fgpm, uint32_t alpha) {
+
+    if (count <= 0) { return; }
+
+    // Align to a word
+    if ((uintptr_t)output & 2) {
+        *output = ffx_blend_premultiplied(fgpm, *output, alpha);
+        output++;
+        count--;
+    }
+
+    uint32_t *words = (uint32_t*)output;
+    for (int32_t i = count >> 1; i; i--) {
+        uint32_t pixels = *words;
+        *words++ = ffx_blend_premultiplied(fgpm, pixels, alpha) |
+          ((uint32_t)ffx_blend_premultiplied(fgpm, pixels >> 16, alpha) << 16);
+    }
+
+    if (count & 1) {
+        output = (uint16_t*)words;
+        *output = ffx_blend_premultiplied(fgpm, *output, alpha);
+    }
+}
+
+
+/**
+ *  Shading, shift-only
+ *
+ *  Black (or white) with an opacity of 4, 8, 16, 24 or 28 (i.e. 12.5%
+ *  through 87.5%) can be blended using only masks, shifts and a
+ *  subtraction, on two pixels per 32-bit word. The low bits of each
+ *  channel are cleared before a shift so nothing carries into the
+ *  neighbouring channel (or pixel).
+ *
+ *  Darkening by 50%, 75% and 87.5% matches the generic blend exactly.
+ *  Darkening by 12.5% and 25% (a subtraction) and all lightening (which
+ *  is darkening the inverted pixels) round up where the generic blend
+ *  rounds down, so a channel may be one LSB brighter.
+ */
+
+#define SHADE_MASK_1      (0xf7def7de)
+#define SHADE_MASK_2      (0xe79ce79c)
+#define SHADE_MASK_3      (0xc718c718)
+
+// The number of opacities with a shift-only kernel
+#define SHADE_COUNT       (5)
+
+/**
+ *  Returns the index of the shift-only kernel for %%opacity%%, or -1 if
+ *  the opacity requires the generic blend.
+ */
+static inline int32_t ffx_blend_getShade(uint32_t opacity) {
+    switch (opacity) {
+        case 4: return 0;
+        case 8: return 1;
+        case 16: return 2;
+        case 24: return 3;
+        case 28: return 4;
+    }
+    return -1;
+}
+
+/**
+ *  Blend black with the opacity of %%shade%% over the (one or two)
+ *  %%pixels%%. The %%shade%% should be a constant, so the switch folds.
+ */
+static inline __attribute__((always_inline)) uint32_t ffx_blend_darken(
+  uint32_t pixels, int32_t shade) {
+    switch (shade) {
+        case 0: return pixels - ((pixels & SHADE_MASK_3) >> 3);
+        case 1: return pixels - ((pixels & SHADE_MASK_2) >> 2);
+        case 2: return (pixels & SHADE_MASK_1) >> 1;
+        case 3: return (pixels & SHADE_MASK_2) >> 2;
+        case 4: return (pixels & SHADE_MASK_3) >> 3;
+    }
+    return pixels;
+}
+
+/**
+ *  Blend white with the opacity of %%shade%% over the (one or two)
+ *  %%pixels%%.
+ */
+static inline __attribute__((always_inline)) uint32_t ffx_blend_lighten(
+  uint32_t pixels, int32_t shade) {
+    return ~ffx_blend_darken(~pixels, shade);
+}
+
+/**
+ *  Darken (or if %%lighten%%, lighten) the %%count%% pixels at %%output%%
+ *  by %%shade%%, two per 32-bit word.
+ */
+static inline __attribute__((always_inline)) void ffx_blend_shadeRow(
+  uint16_t *output, int32_t count, int32_t shade, bool lighten) {
+
+    if (count <= 0) { return; }
+
+    // Align to a word
+    if ((uintptr_t)output & 2) {
+        *output = lighten ? ffx_blend_lighten(*output, shade):
+          ffx_blend_darken(*output, shade);
+        output++;
+        count--;
+    }
+
+    uint32_t *words = (uint32_t*)output;
+    for (int32_t i = count >> 1; i; i--) {
+        *words = lighten ? ffx_blend_lighten(*words, shade):
+          ffx_blend_darken(*words, shade);
+        words++;
+    }
+
+    if (count & 1) {
+        output = (uint16_t*)words;
+        *output = lighten ? ffx_blend_lighten(*output, shade):
+          ffx_blend_darken(*output, shade);
+    }
+}
+
+
+/**
+ *  Filling
+ *
+ *  Opaque fills write an RGB565 color packed twice into a word (i.e.
+ *  %%pixels%%), after aligning the output. Where the native word is
+ *  64-bit (e.g. a host build) the bulk is written four pixels at a time.
+ */
+
+/**
+ *  Returns the RGB565 %%pixel%% packed twice, for word-wide writes.
+ */
+static inline __attribute__((always_inline)) uint32_t ffx_blend_pair(
+  uint16_t pixel) {
+    return ((uint32_t)pixel << 16) | pixel;
+}
+
+/**
+ *  Fill the %%count%% pixels at %%output%% with the packed %%pixels%%.
+ */
+static inline __attribute__((always_inline)) void ffx_blend_fill(
+  uint16_t *output, int32_t count, uint32_t pixels) {
+
+    // Runs of 1 or 2 pixels (e.g. QR modules) are not worth aligning
+    if (count < 3) {
+        while (count-- > 0) { *output++ = pixels; }
+        return;
+    }
+
+    // Align to a word
+    if ((uintptr_t)output & 2) {
+        *output++ = pixels;
+        count--;
+    }
+
+    uint32_t *words = (uint32_t*)output;
+
+#if UINTPTR_MAX > 0xffffffff
+    if (count >= 8) {
+        // Align to a double-word
+        if ((uintptr_t)words & 4) {
+            *words++ = pixels;
+            count -= 2;
+        }
+
+        uint64_t quad = ((uint64_t)pixels << 32) | pixels;
+        uint64_t *dwords = (uint64_t*)words;
+        for (int32_t i = count >> 2; i; i--) { *dwords++ = quad; }
+
+        words = (uint32_t*)dwords;
+        count &= 3;
+    }
+#endif
+
+    for (int32_t i = count >> 1; i; i--) { *words++ = pixels; }
+
+    // Trailing pixel
+    if (count & 1) { *(uint16_t*)words = pixels; }
+}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __FIREFLY_INTERNAL_BLEND_H__ */
@@ -252,3 +252,110 @@ fixed_ffxt FfxCurveEaseInOutBounce(fixed_ffxt t) {
     if (t < FM_1_2) { return (FM_1 - FfxCurveEaseOutBounce(FM_1 - (t << 1))) >> 1; }
     return (FM_1 + FfxCurveEaseOutBounce((t << 1) - FM_1)) >> 1;
 }
+
+
+//////////////////////////
+// Curve Tables
+
+#define TABLE_SHIFT     (16 - FFX_CURVE_TABLE_BITS)
+#define TABLE_MASK      ((1 << TABLE_SHIFT) - 1)
+
+void ffx_curve_initTable(FfxCurveTable *table, FfxCurveFunc curve) {
+    table->curve = curve;
+    for (int i = 0; i <= FFX_CURVE_TABLE_SIZE; i++) {
+        table->values[i] = curve(i << TABLE_SHIFT);
+    }
+}
+
+fixed_ffxt ffx_curve_evalTable(const FfxCurveTable *table, fixed_ffxt t) {
+    if (t <= 0) { return table->values[0]; }
+    if (t >= FM_1) { return table->values[FFX_CURVE_TABLE_SIZE]; }
+
+    const fixed_ffxt *values = &table->values[t >> TABLE_SHIFT];
+    return values[0] + (((values[1] - values[0]) * (t & TABLE_MASK)) >>
+      TABLE_SHIFT);
+}
+
+void ffx_curve_sampleTable(FfxCurveTable *table, FfxCurveSampleFunc sampleFunc,
+  void *context) {
+    table->curve = NULL;
+    for (int i = 0; i <= FFX_CURVE_TABLE_SIZE; i++) {
+        table->values[i] = sampleFunc(i << TABLE_SHIFT, context);
+    }
+}
+
+typedef struct BezierState {
+    fixed_ffxt x1, y1, x2, y2;
+} BezierState;
+
+// One coordinate of the bezier (with end points 0 and 1) at %%s%%
+static int64_t bezier(int64_t p1, int64_t p2, int64_t s) {
+    int64_t u = FM_1 - s;
+    int64_t uus = (((u * u) >> 16) * s) >> 16;
+    int64_t uss = (((s * s) >> 16) * u) >> 16;
+    int64_t sss = (((s * s) >> 16) * s) >> 16;
+    return ((3 * uus * p1 + 3 * uss * p2) >> 16) + sss;
+}
+
+static fixed_ffxt sampleBezier(fixed_ffxt t, void *context) {
+    BezierState *state = context;
+
+    // The x coordinate is monotonic for control points within [0, 1],
+    // so bisect for the parameter which reaches t
+    int32_t lo = 0, hi = FM_1;
+    while (hi - lo > 1) {
+        int32_t mid = (lo + hi) >> 1;
+        if (bezier(state->x1, state->x2, mid) < t) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return bezier(state->y1, state->y2, hi);
+}
+
+bool ffx_curve_initBezier(FfxCurveTable *table, fixed_ffxt x1, fixed_ffxt y1,
+  fixed_ffxt x2, fixed_ffxt y2) {
+    if (x1 < 0 || x1 > FM_1 || x2 < 0 || x2 > FM_1) { return false; }
+
+    BezierState state = { .x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2 };
+    ffx_curve_sampleTable(table, sampleBezier, &state);
+
+    return true;
+}
+
+typedef struct PiecewiseState {
+    const FfxCurvePoint *points;
+    size_t count;
+} PiecewiseState;
+
+static fixed_ffxt samplePiecewise(fixed_ffxt t, void *context) {
+    PiecewiseState *state = context;
+    const FfxCurvePoint *points = state->points;
+
+    if (t < points[0].t) { return points[0].value; }
+
+    for (size_t i = 1; i < state->count; i++) {
+        if (t >= points[i].t) { continue; }
+
+        const FfxCurvePoint *p0 = &points[i - 1], *p1 = &points[i];
+        return p0->value + ((int64_t)(p1->value - p0->value) *
+          (t - p0->t)) / (p1->t - p0->t);
+    }
+
+    return points[state->count - 1].value;
+}
+
+bool ffx_curve_initPiecewise(FfxCurveTable *table, const FfxCurvePoint *points,
+  size_t count) {
+    if (count == 0) { return false; }
+    for (size_t i = 1; i < count; i++) {
+        if (points[i].t < points[i - 1].t) { return false; }
+    }
+
+    PiecewiseState state = { .points = points, .count = count };
+    ffx_curve_sampleTable(table, samplePiecewise, &state);
+
+    return true;
+}
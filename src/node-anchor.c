@@ -1,6 +1,7 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "firefly-scene-private.h"
 #include "scene.h"
@@ -8,6 +9,9 @@
 typedef struct AnchorNode {
     FfxNode child;
     FfxNodeTag tag;
+
+    // The next anchor in the index with the same tag
+    Node *nextAnchor;
 } AnchorNode;
 
 
@@ -16,7 +20,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "AnchorNode";
@@ -30,6 +34,155 @@ static const FfxNodeVTable vtable = {
 };
 
 
+//////////////////////////
+// Index
+
+static uint32_t hashTag(FfxNodeTag tag) {
+    return (uint32_t)tag * 0x9e3779b1;
+}
+
+// Returns the slot for %%tag%%, or the empty slot it belongs in
+static AnchorSlot* findSlot(Scene *scene, FfxNodeTag tag) {
+    uint32_t mask = scene->anchorCapacity - 1;
+    uint32_t index = hashTag(tag) & mask;
+
+    while (true) {
+        AnchorSlot *slot = &scene->anchorSlots[index];
+        if (slot->anchor == NULL || slot->tag == tag) { return slot; }
+        index = (index + 1) & mask;
+    }
+}
+
+// Grow the index so it can hold another tag with a load factor of
+// at most 1/2
+static bool growIndex(Scene *scene) {
+    if (2 * (scene->anchorCount + 1) <= scene->anchorCapacity) {
+        return true;
+    }
+
+    uint32_t capacity = scene->anchorCapacity ?
+      2 * scene->anchorCapacity: ANCHOR_INDEX_SIZE;
+
+    AnchorSlot *slots = (void*)scene->allocFunc(capacity * sizeof(AnchorSlot),
+      scene->initArg);
+    if (slots == NULL) { return false; }
+    memset(slots, 0, capacity * sizeof(AnchorSlot));
+
+    AnchorSlot *oldSlots = scene->anchorSlots;
+    uint32_t oldCapacity = scene->anchorCapacity;
+
+    scene->anchorSlots = slots;
+    scene->anchorCapacity = capacity;
+
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].anchor == NULL) { continue; }
+        *findSlot(scene, oldSlots[i].tag) = oldSlots[i];
+    }
+
+    if (oldSlots) { scene->freeFunc((void*)oldSlots, scene->initArg); }
+
+    return true;
+}
+
+static void indexAnchor(Node *node) {
+    Scene *scene = node->scene;
+    AnchorNode *anchor = ffx_sceneNode_getState(node, &vtable);
+
+    if (!growIndex(scene)) {
+        printf("failed to index anchor: tag=%d\n", anchor->tag);
+        return;
+    }
+
+    AnchorSlot *slot = findSlot(scene, anchor->tag);
+    if (slot->anchor == NULL) {
+        slot->tag = anchor->tag;
+        scene->anchorCount++;
+    }
+
+    anchor->nextAnchor = slot->anchor;
+    slot->anchor = node;
+}
+
+static void unindexAnchor(Node *node) {
+    Scene *scene = node->scene;
+    AnchorNode *anchor = ffx_sceneNode_getState(node, &vtable);
+
+    if (scene->anchorCapacity == 0) { return; }
+
+    AnchorSlot *slot = findSlot(scene, anchor->tag);
+
+    // Unlink the anchor from the slot's list
+    Node **link = &slot->anchor;
+    while (*link && *link != node) {
+        link = &((AnchorNode*)ffx_sceneNode_getState(*link,
+          &vtable))->nextAnchor;
+    }
+    if (*link == NULL) { return; }
+    *link = anchor->nextAnchor;
+    anchor->nextAnchor = NULL;
+
+    if (slot->anchor) { return; }
+
+    // The tag has no more anchors; remove the slot, shifting back any
+    // following entries which would no longer be reachable
+    scene->anchorCount--;
+
+    uint32_t mask = scene->anchorCapacity - 1;
+    uint32_t hole = slot - scene->anchorSlots;
+    uint32_t index = hole;
+    while (true) {
+        index = (index + 1) & mask;
+        AnchorSlot *next = &scene->anchorSlots[index];
+        if (next->anchor == NULL) { break; }
+
+        // Only move entries whose home lies cyclically outside (hole, index]
+        uint32_t home = hashTag(next->tag) & mask;
+        if (((index - home) & mask) < ((index - hole) & mask)) { continue; }
+
+        scene->anchorSlots[hole] = *next;
+        hole = index;
+    }
+
+    scene->anchorSlots[hole].anchor = NULL;
+}
+
+// Whether %%node%% is within the subtree of %%root%% and not removed
+static bool isWithin(Node *node, Node *root) {
+    while (node) {
+        if (node == root) { return true; }
+        if (node->flags & NodeFlagRemove) { return false; }
+        node = node->parent;
+    }
+    return false;
+}
+
+size_t ffx_sceneNode_findAnchors(FfxNode _node, FfxNodeTag tag,
+  FfxNode *anchors, size_t count) {
+
+    Node *node = _node;
+    Scene *scene = node->scene;
+
+    if (scene->anchorCapacity == 0) { return 0; }
+
+    size_t found = 0;
+
+    Node *candidate = findSlot(scene, tag)->anchor;
+    while (candidate && found < count) {
+        if (isWithin(candidate, node)) { anchors[found++] = candidate; }
+        candidate = ((AnchorNode*)ffx_sceneNode_getState(candidate,
+          &vtable))->nextAnchor;
+    }
+
+    return found;
+}
+
+FfxNode ffx_sceneNode_findAnchor(FfxNode node, FfxNodeTag tag) {
+    FfxNode anchor = NULL;
+    ffx_sceneNode_findAnchors(node, tag, &anchor, 1);
+    return anchor;
+}
+
+
 //////////////////////////
 // Methods
 
@@ -48,6 +201,8 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 }
 
 static void destroyFunc(FfxNode node) {
+    unindexAnchor(node);
+
     AnchorNode *anchor = ffx_sceneNode_getState(node, &vtable);
     if (anchor->child) {
         ffx_sceneNode_free(anchor->child);
@@ -66,7 +221,7 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
 }
 
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 }
 
 static void dumpFunc(FfxNode node, int indent) {
@@ -92,12 +247,15 @@ FfxNode ffx_scene_createAnchor(FfxScene scene, FfxNodeTag tag, size_t dataSize,
         child = NULL;
     } else {
         ffx_sceneNode_setFlags(child, NodeFlagHasParent);
+        ((Node*)child)->parent = node;
     }
 
     AnchorNode *anchor = ffx_sceneNode_getState(node, &vtable);
     anchor->tag = tag;
     anchor->child = child;
 
+    indexAnchor(node);
+
     return node;
 }
 
@@ -117,8 +275,11 @@ FfxNodeTag ffx_sceneAnchor_getTag(FfxNode node) {
 
 void ffx_sceneAnchor_setTag(FfxNode node, FfxNodeTag tag) {
     AnchorNode *anchor = ffx_sceneNode_getState(node, &vtable);
-    if (anchor == NULL) { return; }
-    anchor->tag = tag;;
+    if (anchor == NULL || anchor->tag == tag) { return; }
+
+    unindexAnchor(node);
+    anchor->tag = tag;
+    indexAnchor(node);
 }
 
 FfxNode ffx_sceneAnchor_getChild(FfxNode node) {
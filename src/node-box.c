@@ -3,6 +3,8 @@
 
 #include "firefly-scene-private.h"
 
+#include "blend.h"
+
 
 typedef struct BoxNode {
     FfxSize size;
@@ -21,7 +23,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "BoxNode";
@@ -54,7 +56,8 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     pos.x += worldPos.x;
     pos.y += worldPos.y;
 
-    if (pos.x >= 240 || pos.y >= 240) { return; }
+    FfxSize screen = ffx_scene_getSize(ffx_sceneNode_getScene(node));
+    if (pos.x >= screen.width || pos.y >= screen.height) { return; }
 
     BoxNode *box = ffx_sceneNode_getState(node, &vtable);
 
@@ -65,103 +68,191 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     render->size = box->size;
     render->color = box->color;
     render->position = pos;
-}
 
-static void renderBoxBlend(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height, color_ffxt _color) {
+    ffx_scene_setRenderBounds(render, pos, box->size);
+    ffx_scene_setRenderOpaque(render,
+      ffx_color_getOpacity(box->color) == MAX_OPACITY);
+}
 
-    FfxColorRGB color = ffx_color_parseRGB(_color);
+// The kernels take the stride as a parameter, but are always inlined into
+// the per-stride specializations below, so for the common strides it is
+// a constant folded into the addressing
 
-    // Pad alpha with 11 zeros (i.e. 0x20 => 0x10000; 1 in fixed-point)
-    fixed_ffxt alpha = color.opacity << 11;
-    fixed_ffxt alpha_1 = FM_1 - alpha;
+static inline __attribute__((always_inline)) void renderBoxBlend(
+  uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy,
+  int32_t width, int32_t height, color_ffxt _color) {
 
-    // Get the premultiplied color components as fixed values
-    int r = (color.red * alpha) >> 3;
-    int g = (color.green * alpha) >> 2;
-    int b = (color.blue * alpha) >> 3;
+    uint32_t alpha = ffx_color_getOpacity(_color);
+    uint32_t fgpm = ffx_blend_premultiply(ffx_color_rgb16(_color), alpha);
 
     for (uint32_t y = 0; y < height; y++) {
-        uint16_t *output = &frameBuffer[240 * (oy + y) + ox];
-        for (uint32_t x = 0; x < width; x++) {
-
-            // Get the background RGB565 components
-            uint16_t bg = *output;
-            int bgR = bg >> 11;
-            int bgG = (bg >> 5) & 0x3f;
-            int bgB = bg & 0x1f;
-
-            // Blend the values and convert from fixed-point
-            int blendR = (r + (alpha_1 * bgR)) >> 16;
-            int blendG = (g + (alpha_1 * bgG)) >> 16;
-            int blendB = (b + (alpha_1 * bgB)) >> 16;
-
-            *output++ = (blendR << 11) | (blendG << 5) | blendB;
-        }
+        ffx_blend_row(&frameBuffer[stride * (oy + y) + ox], width, fgpm,
+          alpha);
     }
 }
 
-static void renderBoxDarker50(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height) {
+// Black or white at one of the shift-only opacities; see blend.h
+static inline __attribute__((always_inline)) void renderBoxShade(
+  uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy,
+  int32_t width, int32_t height, int32_t shade, bool lighten) {
 
     for (uint32_t y = 0; y < height; y++) {
-        uint16_t *output = &frameBuffer[240 * (oy + y) + ox];
-        for (uint32_t x = 0; x < width; x++) {
-            // (RRRR 0GGG GG0B BBB0) >> 1
-            uint16_t darker = ((*output) & 0xf7de) >> 1;
-            *output++ = darker;
-        }
+        ffx_blend_shadeRow(&frameBuffer[stride * (oy + y) + ox], width,
+          shade, lighten);
     }
 }
 
-static void renderBoxDarker75(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height) {
+#define SHADE_KERNELS(shade) \
+  static inline __attribute__((always_inline)) void renderBoxDarken##shade( \
+    uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy, \
+    int32_t width, int32_t height, color_ffxt color) { \
+      renderBoxShade(frameBuffer, stride, ox, oy, width, height, shade, \
+        false); \
+  } \
+  static inline __attribute__((always_inline)) void renderBoxLighten##shade( \
+    uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy, \
+    int32_t width, int32_t height, color_ffxt color) { \
+      renderBoxShade(frameBuffer, stride, ox, oy, width, height, shade, \
+        true); \
+  }
+
+SHADE_KERNELS(0)
+SHADE_KERNELS(1)
+SHADE_KERNELS(2)
+SHADE_KERNELS(3)
+SHADE_KERNELS(4)
+
+static inline __attribute__((always_inline)) void renderBoxFill(
+  uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy,
+  int32_t width, int32_t height, uint32_t pixels) {
+
+    // The rows are contiguous; fill them as a single run
+    if (width == stride) {
+        width *= height;
+        height = 1;
+    }
 
     for (uint32_t y = 0; y < height; y++) {
-        uint16_t *output = &frameBuffer[240 * (oy + y) + ox];
-        for (uint32_t x = 0; x < width; x++) {
-            // (RRR0 0GGG G00B BB00) >> 2
-            uint16_t darker = ((*output) & 0xe79c) >> 2;
-            *output++ = darker;
-        }
+        ffx_blend_fill(&frameBuffer[stride * (oy + y) + ox], width, pixels);
     }
 }
 
-static void renderBoxOpaque(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height, color_ffxt _color) {
+static inline __attribute__((always_inline)) void renderBoxOpaque(
+  uint16_t *frameBuffer, const int32_t stride, int32_t ox, int32_t oy,
+  int32_t width, int32_t height, color_ffxt color) {
 
-    uint16_t color = ffx_color_rgb16(_color) & 0xffff;
+    renderBoxFill(frameBuffer, stride, ox, oy, width, height,
+      ffx_blend_pair(ffx_color_rgb16(color)));
+}
 
-    for (uint32_t y = 0; y < height; y++) {
-        uint16_t *output = &frameBuffer[240 * (oy + y) + ox];
-        for (uint32_t x = 0; x < width; x++) {
-            *output++ = color;
-        }
+typedef void (*BoxKernel)(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, color_ffxt color);
+
+typedef struct BoxKernels {
+    BoxKernel blend;
+    BoxKernel darken[SHADE_COUNT];
+    BoxKernel lighten[SHADE_COUNT];
+    BoxKernel opaque;
+} BoxKernels;
+
+#define BOX_KERNEL(name,stride) \
+  static void name##_##stride(uint16_t *frameBuffer, int32_t _stride, \
+    int32_t ox, int32_t oy, int32_t width, int32_t height, \
+    color_ffxt color) { \
+      name(frameBuffer, stride, ox, oy, width, height, color); \
+  }
+
+#define BOX_KERNELS(stride) \
+  BOX_KERNEL(renderBoxBlend, stride) \
+  BOX_KERNEL(renderBoxDarken0, stride) \
+  BOX_KERNEL(renderBoxDarken1, stride) \
+  BOX_KERNEL(renderBoxDarken2, stride) \
+  BOX_KERNEL(renderBoxDarken3, stride) \
+  BOX_KERNEL(renderBoxDarken4, stride) \
+  BOX_KERNEL(renderBoxLighten0, stride) \
+  BOX_KERNEL(renderBoxLighten1, stride) \
+  BOX_KERNEL(renderBoxLighten2, stride) \
+  BOX_KERNEL(renderBoxLighten3, stride) \
+  BOX_KERNEL(renderBoxLighten4, stride) \
+  BOX_KERNEL(renderBoxOpaque, stride) \
+  static const BoxKernels boxKernels_##stride = { \
+      .blend = renderBoxBlend_##stride, \
+      .darken = { \
+          renderBoxDarken0_##stride, renderBoxDarken1_##stride, \
+          renderBoxDarken2_##stride, renderBoxDarken3_##stride, \
+          renderBoxDarken4_##stride \
+      }, \
+      .lighten = { \
+          renderBoxLighten0_##stride, renderBoxLighten1_##stride, \
+          renderBoxLighten2_##stride, renderBoxLighten3_##stride, \
+          renderBoxLighten4_##stride \
+      }, \
+      .opaque = renderBoxOpaque_##stride \
+  };
+
+// Specialized for the common panel widths (240x240 and 320x240), with
+// the generic kernels using the stride passed in
+BOX_KERNELS(240)
+BOX_KERNELS(320)
+BOX_KERNELS(_stride)
+
+static const BoxKernels* getBoxKernels(int32_t stride) {
+    switch (stride) {
+        case 240: return &boxKernels_240;
+        case 320: return &boxKernels_320;
     }
+    return &boxKernels__stride;
 }
 
-void _ffx_renderBox(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height, color_ffxt color) {
+void _ffx_renderBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, color_ffxt color) {
 
-    if (color == RGBA_DARKER50) {
-        renderBoxDarker50(frameBuffer, ox, oy, width, height);
-        return;
+    const BoxKernels *kernels = getBoxKernels(stride);
+
+    uint32_t opacity = ffx_color_getOpacity(color);
+
+    // Black or white at a base-2 fraction opacity (e.g. RGBA_DARKER50)
+    int32_t shade = ffx_blend_getShade(opacity);
+    if (shade >= 0) {
+        uint16_t rgb16 = ffx_color_rgb16(color);
+        if (rgb16 == 0x0000) {
+            kernels->darken[shade](frameBuffer, stride, ox, oy, width,
+              height, color);
+            return;
+        }
+        if (rgb16 == 0xffff) {
+            kernels->lighten[shade](frameBuffer, stride, ox, oy, width,
+              height, color);
+            return;
+        }
     }
 
-    if (color == RGBA_DARKER75) {
-        renderBoxDarker75(frameBuffer, ox, oy, width, height);
+    if (opacity == MAX_OPACITY) {
+        kernels->opaque(frameBuffer, stride, ox, oy, width, height, color);
         return;
     }
 
-    if (ffx_color_getOpacity(color) == MAX_OPACITY) {
-        renderBoxOpaque(frameBuffer, ox, oy, width, height, color);
-        return;
+    kernels->blend(frameBuffer, stride, ox, oy, width, height, color);
+}
+
+// Fill with the packed RGB565 pixels (see ffx_blend_pair); shared by the
+// fill and QR nodes, which have already resolved an opaque color
+void _ffx_fillBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, uint32_t pixels) {
+
+    switch (stride) {
+        case 240:
+            renderBoxFill(frameBuffer, 240, ox, oy, width, height, pixels);
+            return;
+        case 320:
+            renderBoxFill(frameBuffer, 320, ox, oy, width, height, pixels);
+            return;
     }
 
-    renderBoxBlend(frameBuffer, ox, oy, width, height, color);
+    renderBoxFill(frameBuffer, stride, ox, oy, width, height, pixels);
 }
 
-static void renderFunc(void *_render, uint16_t *frameBuffer,
+static void renderFunc(void *_render, uint16_t *frameBuffer, int32_t stride,
   FfxPoint origin, FfxSize size) {
 
     BoxRender *render = _render;
@@ -171,7 +262,7 @@ static void renderFunc(void *_render, uint16_t *frameBuffer,
 
     if (clip.width == 0) { return; }
 
-    _ffx_renderBox(frameBuffer, clip.vpX, clip.vpY, clip.width, clip.height,
+    _ffx_renderBox(frameBuffer, stride, clip.vpX, clip.vpY, clip.width, clip.height,
         render->color);
 }
 
@@ -219,6 +310,7 @@ static void setColor(FfxNode node, color_ffxt color) {
     BoxNode *box = ffx_sceneNode_getState(node, &vtable);
     if (box == NULL) { return; }
     box->color = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneBox_setColor(FfxNode node, color_ffxt color) {
@@ -243,6 +335,7 @@ static void setSize(FfxNode node, FfxSize size) {
     BoxNode *box = ffx_sceneNode_getState(node, &vtable);
     if (box == NULL) { return; }
     box->size = size;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneBox_setSize(FfxNode node, FfxSize size) {
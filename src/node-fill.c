@@ -3,18 +3,27 @@
 
 #include "firefly-scene-private.h"
 
+#include "blend.h"
+
 
 typedef struct FillNode {
     color_ffxt color;
 } FillNode;
 
+typedef struct FillRender {
+    color_ffxt color;
+
+    // The RGB565 color packed twice, for word-wide writes
+    uint32_t pixels;
+} FillRender;
+
 
 static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
   FfxNodeVisitFunc exitFunc, void* arg);
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
-static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+static void renderFunc(void *_render, uint16_t *frameBuffer,
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "FillNode";
@@ -43,25 +52,39 @@ static void destroyFunc(FfxNode node) { }
 static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     FillNode *fill = ffx_sceneNode_getState(node, &vtable);
 
-    FillNode *render = ffx_scene_createRender(node, sizeof(FillNode));
+    if (ffx_color_isTransparent(fill->color)) { return; }
+
+    FillRender *render = ffx_scene_createRender(node, sizeof(FillRender));
     render->color = fill->color;
-}
 
-static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size) {
+    render->pixels = ffx_blend_pair(ffx_color_rgb16(fill->color));
+
+    ffx_scene_setRenderOpaque(render,
+      ffx_color_getOpacity(fill->color) == MAX_OPACITY);
+}
 
-    FillNode *render = _render;
+// See: node-box.c
+void _ffx_renderBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, color_ffxt color);
 
-    uint32_t c = ffx_color_rgb16(render->color);
-    c = ((c << 16) | c);
+void _ffx_fillBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, uint32_t pixels);
 
-    uint32_t *frameBuffer = (uint32_t*)_frameBuffer;
+static void renderFunc(void *_render, uint16_t *frameBuffer,
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
-    // @TODO: this doesn't work in general anymore; render line-by-line
+    FillRender *render = _render;
 
-    uint32_t count = size.width * size.height / 2;
+    // A fill covers the entire viewport
+    if (ffx_color_getOpacity(render->color) == MAX_OPACITY) {
+        _ffx_fillBox(frameBuffer, stride, 0, 0, size.width, size.height,
+          render->pixels);
+        return;
+    }
 
-    for (uint32_t i = 0; i < count; i++) { *frameBuffer++ = c; }
+    // Translucent (including the darken and lighten fast paths)
+    _ffx_renderBox(frameBuffer, stride, 0, 0, size.width, size.height,
+      render->color);
 }
 
 static void dumpFunc(FfxNode node, int indent) {
@@ -104,6 +127,7 @@ static void setColor(FfxNode node, color_ffxt color) {
     FillNode *fill = ffx_sceneNode_getState(node, &vtable);
     if (fill == NULL) { return; }
     fill->color = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneFill_setColor(FfxNode node, color_ffxt color) {
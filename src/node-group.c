@@ -15,7 +15,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "GroupNode";
@@ -114,7 +114,7 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
 }
 
 static void renderFunc(void *_render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 }
 
 static void dumpFunc(FfxNode node, int indent) {
@@ -159,11 +159,12 @@ void ffx_sceneGroup_appendChild(FfxNode node, FfxNode child) {
         printf("child already has a parent; not added\n");
         return;
     }
-    ffx_sceneNode_setFlags(child, NodeFlagHasParent);
-
     GroupNode *state = ffx_sceneNode_getState(node, &vtable);
     if (state == NULL) { return; }
 
+    ffx_sceneNode_setFlags(child, NodeFlagHasParent);
+    ((Node*)child)->parent = node;
+
     if (state->firstChild == NULL) {
         state->firstChild = state->lastChild = child;
     } else {
@@ -172,4 +173,6 @@ void ffx_sceneGroup_appendChild(FfxNode node, FfxNode child) {
         lastChild->nextSibling = child;
         state->lastChild = child;
     }
+
+    ffx_sceneNode_setDirty(node);
 }
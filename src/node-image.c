@@ -4,6 +4,8 @@
 #include "firefly-scene-private.h"
 #include "firefly-fixed.h"
 
+#include "blend.h"
+
 
 typedef struct ImageNode {
     const uint16_t *data;
@@ -14,6 +16,13 @@ typedef struct ImageRender {
     FfxPoint position;
     const uint16_t *data;
     color_ffxt tint;
+
+    // The scene, for its blitFunc; only populated for RGB565 images
+    FfxScene scene;
+
+    // The blend alpha for each 4-bit alpha, with the tint opacity
+    // applied; only populated for RGB565_A4 images
+    uint8_t alphaLevels[16];
 } ImageRender;
 
 
@@ -22,7 +31,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "ImageNode";
@@ -40,7 +49,7 @@ static const FfxNodeVTable vtable = {
 // Image Rasterizing
 
 static  void _renderRGB565(ImageRender *render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     const uint16_t *data = render->data;
     int16_t width = data[1];
@@ -55,19 +64,26 @@ static  void _renderRGB565(ImageRender *render, uint16_t *frameBuffer,
     // Skip the header bytes
     data += 3;
 
+    uint16_t *output = &frameBuffer[(stride * clip.vpY) + clip.vpX];
+    const uint16_t *input = &data[(clip.y * width) + clip.x];
+
+    // The clipped rows are contiguous in both; copy them as a single run
+    if (clip.width == width && clip.width == stride) {
+        ffx_scene_blit(render->scene, output, input,
+          clip.width * clip.height * sizeof(uint16_t));
+        return;
+    }
+
     for (int32_t y = clip.height; y; y--) {
-        uint16_t *output = &frameBuffer[(240 * (clip.vpY + y - 1)) + clip.vpX];
-        const uint16_t *input = &data[((clip.y + y - 1) * width) + clip.x];
-        for (int32_t x = clip.width; x; x--) {
-            *output++ = *input++;
-        }
+        ffx_scene_blit(render->scene, output, input,
+          clip.width * sizeof(uint16_t));
+        output += stride;
+        input += width;
     }
 }
 
-#define UFIXED_1_21_ONE       (0x200000)
-
 static  void _renderRGB565_A4(ImageRender *render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     const uint16_t *data = render->data;
     int16_t width = data[1];
@@ -85,11 +101,11 @@ static  void _renderRGB565_A4(ImageRender *render, uint16_t *frameBuffer,
     // Point to the bitmap data (advance past the alpha data)
     data += alphaCount + 3 + 1;
 
-    // Additional alpha (from tint) to apply; ufixed:1.5
-    int32_t opacity = ffx_color_getOpacity(render->tint);
+    const uint8_t *alphaLevels = render->alphaLevels;
 
     for (int32_t y = clip.height; y; y--) {
-        uint16_t *output = &frameBuffer[(240 * (clip.vpY + y - 1)) + clip.vpX];
+        uint16_t *output = &frameBuffer[(stride * (clip.vpY + y - 1)) +
+          clip.vpX];
 
         const uint16_t *input = &data[((clip.y + y - 1) * width) + clip.x];
         uint16_t ia = (((clip.y + y - 1) * width) + clip.x);
@@ -97,36 +113,17 @@ static  void _renderRGB565_A4(ImageRender *render, uint16_t *frameBuffer,
         for (int32_t x = clip.width; x; x--) {
             uint16_t fg = *input++;
 
-            // Get the alpha (ufixed:1.16 * ufixed:1.5 => ufixed:1.21)
-            uint32_t fga = FIXED_BITS_4((alpha[ia / 4] >> (12 - 4 *
-              (ia % 4))) & 0x0f) * opacity;
+            uint32_t fga = alphaLevels[(alpha[ia / 4] >> (12 - 4 * (ia % 4))) &
+              0x0f];
             ia++;
 
-            if (fga >= UFIXED_1_21_ONE) {
+            if (fga >= MAX_OPACITY) {
                 // Fully opaque
                 *output = fg;
 
             } else if (fga) {
-                // Paritially translucent
-
-                // Get the background RGB565 components
-                uint16_t bg = *output;
-                int bgR = bg >> 11;
-                int bgG = (bg >> 5) & 0x3f;
-                int bgB = bg & 0x1f;
-
-                int fgR = fg >> 11;
-                int fgG = (fg >> 5) & 0x3f;
-                int fgB = fg & 0x1f;
-
-                uint32_t fga_1 = UFIXED_1_21_ONE - fga;
-
-                // Blend the values and convert from fixed-point
-                int blendR = ((fga * fgR) + (fga_1 * bgR)) >> 21;
-                int blendG = ((fga * fgG) + (fga_1 * bgG)) >> 21;
-                int blendB = ((fga * fgB) + (fga_1 * bgB)) >> 21;
-
-                *output = (blendR << 11) | (blendG << 5) | blendB;
+                // Partially translucent
+                *output = ffx_blend(fg, *output, fga);
             }
 
             output++;
@@ -136,7 +133,7 @@ static  void _renderRGB565_A4(ImageRender *render, uint16_t *frameBuffer,
 }
 
 static  void _renderPal8(ImageRender *render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     const uint16_t *data = render->data;
     int16_t width = data[1];
@@ -155,7 +152,8 @@ static  void _renderPal8(ImageRender *render, uint16_t *frameBuffer,
     data += 3 + 256;
 
     for (int32_t y = clip.height; y; y--) {
-        uint16_t *output = &frameBuffer[(240 * (clip.vpY + y - 1)) + clip.vpX];
+        uint16_t *output = &frameBuffer[(stride * (clip.vpY + y - 1)) +
+          clip.vpX];
         const uint8_t *input = &pixels[((clip.y + y - 1) * width) + clip.x];
         for (int32_t x = clip.width; x; x--) {
             *output++ = palette[*input++];
@@ -207,19 +205,38 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     render->data = state->data;
     render->tint = state->tint;
     render->position = pos;
+
+    if ((state->data[0] & 0x0f) == 0x04) {
+        render->scene = ffx_sceneNode_getScene(node);
+
+    } else if ((state->data[0] & 0x0f) == 0x05) {
+        // Scale each 4-bit alpha (by 1/15) and the tint opacity to
+        // the range [0, MAX_OPACITY], rounding to nearest
+        int32_t opacity = ffx_color_getOpacity(state->tint);
+        for (int i = 0; i < 16; i++) {
+            render->alphaLevels[i] = (i * opacity * 0x1111 + 0x8000) >> 16;
+        }
+    }
+
+    ffx_scene_setRenderBounds(render, pos, ffx_size(state->data[1],
+      state->data[2]));
+
+    // Images without an alpha channel replace every pixel
+    ffx_scene_setRenderOpaque(render, (state->data[0] & 0x0f) == 0x04 ||
+      (state->data[0] & 0xff) == 0x38);
 }
 
 static void renderFunc(void *_render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     ImageRender *render = _render;
 
     if ((render->data[0] & 0x0f) == 0x05) {
-        _renderRGB565_A4(render, frameBuffer, origin, size);
+        _renderRGB565_A4(render, frameBuffer, stride, origin, size);
     } else if ((render->data[0] & 0x0f) == 0x04) {
-        _renderRGB565(render, frameBuffer, origin, size);
+        _renderRGB565(render, frameBuffer, stride, origin, size);
     } else if ((render->data[0] & 0xff) == 0x38) {
-        _renderPal8(render, frameBuffer, origin, size);
+        _renderPal8(render, frameBuffer, stride, origin, size);
     }
 
 }
@@ -276,6 +293,7 @@ void ffx_sceneImage_setData(FfxNode node, const uint16_t *data,
     FfxSize size = ffx_scene_getImageSize(data, length);
     if (size.width) {
         img->data = data;
+        ffx_sceneNode_setDirty(node);
     }
 }
 
@@ -289,6 +307,7 @@ static void setTint(FfxNode node, color_ffxt tint) {
     ImageNode *img = ffx_sceneNode_getState(node, &vtable);
     if (img == NULL) { return; }
     img->tint = tint;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneImage_setTint(FfxNode node, color_ffxt tint) {
@@ -6,6 +6,7 @@
 #include "firefly-scene-private.h"
 #include "firefly-color.h"
 
+#include "blend.h"
 #include "fonts.h"
 
 
@@ -31,7 +32,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "LabelNode";
@@ -48,6 +49,9 @@ static const FfxNodeVTable vtable = {
 #define SPACE_WIDTH       (2)
 #define OUTLINE_WIDTH     (4)
 
+// The last glyph may extend past its cell into the trailing spacing
+#define GLYPH_OVERHANG    (2)
+
 
 //////////////////////////
 // Utilities
@@ -124,11 +128,13 @@ FfxFontMetrics ffx_scene_getFontMetrics(FfxFont font) {
 // NOTE: Alpha blending outlineColor is not currently supported as it
 //       requires memory allocated for a composite layer.
 
-static void renderGlyphOpaque(uint16_t *frameBuffer, int ox, int oy, int width,
-  int height, const uint32_t *data, color_ffxt _color) {
+static void renderGlyphOpaque(uint16_t *frameBuffer, int32_t stride,
+  FfxSize size, int ox, int oy, int width, int height, const uint32_t *data,
+  color_ffxt _color) {
 
     // Glyph is entirely outside the fragment; skip
-    if (ox < -width || ox >= 240 || oy < -height || oy >= 24) { return; }
+    if (ox < -width || ox >= size.width || oy < -height ||
+      oy >= size.height) { return; }
 
     // Get the color, broken into its pre-multiplied components
     uint16_t fg = ffx_color_rgb16(_color);
@@ -145,7 +151,7 @@ static void renderGlyphOpaque(uint16_t *frameBuffer, int ox, int oy, int width,
     }
 
     int ty = oy + y;
-    if (ty >= 24) { return; }
+    if (ty >= size.height) { return; }
 
     // @TODO: Use pointer math instead of multiply
     //uint16_t *output = &frameBuffer[oy * 240 + ox]
@@ -154,8 +160,8 @@ static void renderGlyphOpaque(uint16_t *frameBuffer, int ox, int oy, int width,
         while(mask) {
 
             int tx = ox + x;
-            if (ty >= 0 && tx >= 0 && tx < 240 && (bitmap & mask)) {
-                frameBuffer[ty * 240 + tx] = fg;
+            if (ty >= 0 && tx >= 0 && tx < size.width && (bitmap & mask)) {
+                frameBuffer[ty * stride + tx] = fg;
             }
 
             x++;
@@ -163,7 +169,7 @@ static void renderGlyphOpaque(uint16_t *frameBuffer, int ox, int oy, int width,
                 x = 0;
                 y++;
                 ty = oy + y;
-                if (y >= height || ty >= 24) { return; }
+                if (y >= height || ty >= size.height) { return; }
             }
 
             mask >>= 1;
@@ -173,24 +179,18 @@ static void renderGlyphOpaque(uint16_t *frameBuffer, int ox, int oy, int width,
     }
 }
 
-static void renderGlyphBlend(uint16_t *frameBuffer, int ox, int oy, int width,
-  int height, const uint32_t *data, color_ffxt _color) {
+static void renderGlyphBlend(uint16_t *frameBuffer, int32_t stride,
+  FfxSize size, int ox, int oy, int width, int height, const uint32_t *data,
+  color_ffxt _color) {
 
     // Glyph is entirely outside the fragment; skip
-    if (ox < -width || ox > 240 || oy < -height || oy > 24) { return; }
-
-    // Get the alpha and alpha inverse (ufixed:1.16)
-    uint32_t fga = FIXED_BITS_5(ffx_color_getOpacity(_color));
-    uint32_t fga_1 = FM_1 - fga;
+    if (ox < -width || ox >= size.width || oy < -height ||
+      oy >= size.height) { return; }
 
-    // Get the color, broken into its pre-multiplied components
+    // Get the alpha and the pre-multiplied color
+    uint32_t fga = ffx_color_getOpacity(_color);
     uint16_t fg = ffx_color_rgb16(_color);
-    int fgpmR = fg >> 11;
-    fgpmR *= fga;
-    int fgpmG = (fg >> 5) & 0x3f;
-    fgpmG *= fga;
-    int fgpmB = fg & 0x1f;;
-    fgpmB *= fga;
+    uint32_t fgpm = ffx_blend_premultiply(fg, fga);
 
     int x = 0, y = 0;
     // @TODO: Use pointer math instead of multiply
@@ -200,27 +200,16 @@ static void renderGlyphBlend(uint16_t *frameBuffer, int ox, int oy, int width,
         for (int i = 0; i < 32; i++) {
             int tx = ox + x, ty = oy + y;
             if (bitmap & (0x80000000 >> i)) {
-                if (tx >= 0 && tx < 240 && ty >= 0 && ty < 24) {
+                if (tx >= 0 && tx < size.width && ty >= 0 &&
+                  ty < size.height) {
 
-                    if (fga >= FM_1) {
+                    if (fga >= MAX_OPACITY) {
                         // 100% opaque
-                        frameBuffer[ty * 240 + tx] = fg;
+                        frameBuffer[ty * stride + tx] = fg;
 
                     } else {
-
-                        // Get the current color...
-                        uint16_t bg = frameBuffer[ty * 240 + tx];
-                        int bgR = bg >> 11;
-                        int bgG = (bg >> 5) & 0x3f;
-                        int bgB = bg & 0x1f;
-
-                        // Blend the values and convert from fixed-point
-                        int blendR = (fgpmR + (fga_1 * bgR)) >> 16;
-                        int blendG = (fgpmG + (fga_1 * bgG)) >> 16;
-                        int blendB = (fgpmB + (fga_1 * bgB)) >> 16;
-
-                        frameBuffer[ty * 240 + tx] = (blendR << 11) |
-                          (blendG << 5) | blendB;
+                        uint16_t *output = &frameBuffer[ty * stride + tx];
+                        *output = ffx_blend_premultiplied(fgpm, *output, fga);
                     }
                 }
             }
@@ -235,9 +224,9 @@ static void renderGlyphBlend(uint16_t *frameBuffer, int ox, int oy, int width,
     }
 }
 
-static void renderText(uint16_t *frameBuffer, const char *text,
-  FfxPoint position, const uint32_t *font, int32_t strokeOffset,
-  color_ffxt color) {
+static void renderText(uint16_t *frameBuffer, int32_t stride, FfxSize size,
+  const char *text, FfxPoint position, const uint32_t *font,
+  int32_t strokeOffset, color_ffxt color) {
 
     uint8_t opacity = ffx_color_getOpacity(color);
 
@@ -278,9 +267,11 @@ static void renderText(uint16_t *frameBuffer, const char *text,
         const uint32_t *data = &font[97 + offset];
 
         if (opacity == MAX_OPACITY) {
-            renderGlyphOpaque(frameBuffer, x + gpl, y + gpt, gw, gh, data, color);
+            renderGlyphOpaque(frameBuffer, stride, size, x + gpl, y + gpt, gw,
+              gh, data, color);
         } else {
-            renderGlyphBlend(frameBuffer, x + gpl, y + gpt, gw, gh, data, color);
+            renderGlyphBlend(frameBuffer, stride, size, x + gpl, y + gpt, gw,
+              gh, data, color);
         }
         x += width + SPACE_WIDTH;
     }
@@ -339,7 +330,8 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
             break;
     }
 
-    if (pos.y >= 240 || pos.y + metrics.size.height < 0) { return; }
+    FfxSize screen = ffx_scene_getSize(ffx_sceneNode_getScene(node));
+    if (pos.y >= screen.height || pos.y + metrics.size.height < 0) { return; }
 
     size_t strLen = strlen(label->text);
     if (strLen == 0) { return; }
@@ -356,7 +348,7 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
             break;
     }
 
-    if (pos.x > 240 || pos.x + width <= 0) { return; }
+    if (pos.x > screen.width || pos.x + width <= 0) { return; }
 
     LabelRender *render = ffx_scene_createRender(node, sizeof(LabelRender) +
       ((strLen + 1 + 3) & 0xfffffc)); // @TODO: move this to alloc?
@@ -366,11 +358,16 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     render->position = pos;
 
     strcpy((char*)&render[1], label->text);
+
+    // Include the outline, which extends beyond each glyph cell
+    ffx_scene_setRenderBounds(render, ffx_point(pos.x - OUTLINE_WIDTH,
+      pos.y - OUTLINE_WIDTH), ffx_size(width + GLYPH_OVERHANG +
+      (2 * OUTLINE_WIDTH), metrics.size.height + (2 * OUTLINE_WIDTH)));
 }
 
 
 static void renderFunc(void *_render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     LabelRender *render = _render;
     const char *text = (char*)&render[1];
@@ -396,13 +393,13 @@ static void renderFunc(void *_render, uint16_t *frameBuffer,
     if (clip.width == 0) { return; }
 
     FfxPoint position = {
-        .x = render->position.x,
+        .x = render->position.x - origin.x,
         .y = render->position.y - origin.y
     };
 
-    renderText(frameBuffer, text, position, outlineFont, 0,
+    renderText(frameBuffer, stride, size, text, position, outlineFont, 0,
       render->outlineColor);
-    renderText(frameBuffer, text, position, font, 0,
+    renderText(frameBuffer, stride, size, text, position, font, 0,
       render->textColor);
 }
 
@@ -492,6 +489,8 @@ void ffx_sceneLabel_setTextData(FfxNode node, const uint8_t* data,
     LabelNode *label = ffx_sceneNode_getState(node, &vtable);
     if (label == NULL) { return; }
 
+    ffx_sceneNode_setDirty(node);
+
     if (label->text) {
         ffx_sceneNode_memFree(node, label->text);
         label->text = NULL;
@@ -636,6 +635,7 @@ void ffx_sceneLabel_setAlign(FfxNode node, FfxTextAlign align) {
     LabelNode *label = ffx_sceneNode_getState(node, &vtable);
     if (label == NULL) { return; }
     label->align = align;
+    ffx_sceneNode_setDirty(node);
 }
 
 FfxFont ffx_sceneLabel_getFont(FfxNode node) {
@@ -648,6 +648,7 @@ void ffx_sceneLabel_setFont(FfxNode node, FfxFont font) {
     LabelNode *label = ffx_sceneNode_getState(node, &vtable);
     if (label == NULL) { return; }
     label->font = font;
+    ffx_sceneNode_setDirty(node);
 }
 
 color_ffxt ffx_sceneLabel_getTextColor(FfxNode node) {
@@ -660,6 +661,7 @@ static void setTextColor(FfxNode node, color_ffxt color) {
     LabelNode *label = ffx_sceneNode_getState(node, &vtable);
     if (label == NULL) { return; }
     label->textColor = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneLabel_setTextColor(FfxNode node, color_ffxt color) {
@@ -717,6 +719,7 @@ static void setOutlineColor(FfxNode node, color_ffxt color) {
     LabelNode *label = ffx_sceneNode_getState(node, &vtable);
     if (label == NULL) { return; }
     label->outlineColor = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneLabel_setOutlineColor(FfxNode node, color_ffxt color) {
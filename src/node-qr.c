@@ -5,6 +5,8 @@
 
 #include "firefly-scene-private.h"
 
+#include "blend.h"
+
 ///////////////////////////////
 // <qrcode.h>
 //
@@ -70,7 +72,11 @@ typedef struct QRRender {
 
     color_ffxt fg, bg;
 
-    QRCode *qrCode;
+    // The modules pointer is not used; the modules are copied after
+    // the render state, since the node may be freed while rendering
+    QRCode qrCode;
+
+    // Module data here
 } QRRender;
 
 static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
@@ -78,7 +84,7 @@ static bool walkFunc(FfxNode node, FfxNodeVisitFunc enterFunc,
 static void destroyFunc(FfxNode node);
 static void sequenceFunc(FfxNode node, FfxPoint worldPos);
 static void renderFunc(void *_render, uint16_t *_frameBuffer,
-  FfxPoint origin, FfxSize size);
+  int32_t stride, FfxPoint origin, FfxSize size);
 static void dumpFunc(FfxNode node, int indent);
 
 static const char name[] = "QRNode";
@@ -110,7 +116,8 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
     pos.x += worldPos.x;
     pos.y += worldPos.y;
 
-    if (pos.x >= 240 || pos.y >= 240) { return; }
+    FfxSize screen = ffx_scene_getSize(ffx_sceneNode_getScene(node));
+    if (pos.x >= screen.width || pos.y >= screen.height) { return; }
 
     QRNode *qr = ffx_sceneNode_getState(node, &vtable);
 
@@ -118,26 +125,42 @@ static void sequenceFunc(FfxNode node, FfxPoint worldPos) {
 
     if (pos.x + size < 0 || pos.y + size < 0) { return; }
 
-    QRRender *render = ffx_scene_createRender(node, sizeof(QRRender));
+    size_t moduleBytes = qrcode_getBufferSize(qr->qrCode.version);
+
+    QRRender *render = ffx_scene_createRender(node, sizeof(QRRender) +
+      moduleBytes);
 
     render->position = pos;
     render->moduleSize = qr->moduleSize;
     render->quietZone = qr->quietZone;
     render->fg = qr->fg;
     render->bg = qr->bg;
-    render->qrCode = &qr->qrCode;
+    render->qrCode = qr->qrCode;
+    render->qrCode.modules = NULL;
+
+    memcpy(&render[1], qr->qrCode.modules, moduleBytes);
+
+    ffx_scene_setRenderBounds(render, pos, ffx_size(size, size));
+    ffx_scene_setRenderOpaque(render,
+      ffx_color_getOpacity(qr->bg) == MAX_OPACITY);
 }
 
 // See: node-box.c
-void _ffx_renderBox(uint16_t *frameBuffer, int32_t ox, int32_t oy,
-  int32_t width, int32_t height, color_ffxt _color);
+void _ffx_renderBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, color_ffxt color);
+
+void _ffx_fillBox(uint16_t *frameBuffer, int32_t stride, int32_t ox,
+  int32_t oy, int32_t width, int32_t height, uint32_t pixels);
 
 static void renderFunc(void *_render, uint16_t *frameBuffer,
-  FfxPoint origin, FfxSize size) {
+  int32_t stride, FfxPoint origin, FfxSize size) {
 
     QRRender *render = _render;
 
-    uint16_t bgSize = QR_SIZE(render->qrCode->version, render->moduleSize,
+    QRCode qrCode = render->qrCode;
+    qrCode.modules = (uint8_t*)&render[1];
+
+    uint16_t bgSize = QR_SIZE(qrCode.version, render->moduleSize,
       render->quietZone);
 
     FfxClip clip = ffx_scene_clip(render->position, ffx_size(bgSize, bgSize),
@@ -146,28 +169,44 @@ static void renderFunc(void *_render, uint16_t *frameBuffer,
     if (clip.width == 0) { return; }
 
     // Color the background color
-    _ffx_renderBox(frameBuffer, clip.vpX, clip.vpY, clip.width, clip.height,
-      render->bg);
+    _ffx_renderBox(frameBuffer, stride, clip.vpX, clip.vpY, clip.width,
+      clip.height, render->bg);
 
     int32_t quiet = render->quietZone;
-    FfxSize modSize = ffx_size(render->moduleSize, render->moduleSize);
+    int32_t modSize = render->moduleSize;
+
+    // An opaque foreground is filled directly, skipping the dispatch
+    bool opaque = (ffx_color_getOpacity(render->fg) == MAX_OPACITY);
+    uint32_t pixels = ffx_blend_pair(ffx_color_rgb16(render->fg));
 
     // @TODO: This can be significantly optimized
     // - compute the start and end modules for the viewport?
 
-    uint8_t mods = QR_SIZE(render->qrCode->version, 1, 0);
+    uint8_t mods = QR_SIZE(qrCode.version, 1, 0);
     for (int32_t y = 0; y < mods; y++) {
         for (int32_t x = 0; x < mods; x++) {
-            if (qrcode_getModule(render->qrCode, x, y)) {
-                int32_t bx = render->position.x + modSize.width * (quiet + x);
-                int32_t by = render->position.y + modSize.height * (quiet + y);
+            if (!qrcode_getModule(&qrCode, x, y)) { continue; }
 
-                FfxClip b = ffx_scene_clip(ffx_point(bx, by), modSize,
-                  origin, size);
-                if (b.width == 0) { continue; }
+            // Each horizontal run of dark modules is a single box
+            int32_t run = 1;
+            while (x + run < mods && qrcode_getModule(&qrCode, x + run, y)) {
+                run++;
+            }
 
-                _ffx_renderBox(frameBuffer, b.vpX, b.vpY, b.width, b.height,
-                  render->fg);
+            int32_t bx = render->position.x + modSize * (quiet + x);
+            int32_t by = render->position.y + modSize * (quiet + y);
+            x += run;
+
+            FfxClip b = ffx_scene_clip(ffx_point(bx, by),
+              ffx_size(modSize * run, modSize), origin, size);
+            if (b.width == 0) { continue; }
+
+            if (opaque) {
+                _ffx_fillBox(frameBuffer, stride, b.vpX, b.vpY, b.width,
+                  b.height, pixels);
+            } else {
+                _ffx_renderBox(frameBuffer, stride, b.vpX, b.vpY, b.width,
+                  b.height, render->fg);
             }
         }
     }
@@ -320,6 +359,7 @@ void ffx_sceneQR_setModuleSize(FfxNode node, uint8_t moduleSize) {
     QRNode *qr = ffx_sceneNode_getState(node, &vtable);
     if (qr == NULL) { return; }
     qr->moduleSize = moduleSize;
+    ffx_sceneNode_setDirty(node);
 }
 
 uint8_t ffx_sceneQR_getQuietZone(FfxNode node) {
@@ -332,6 +372,7 @@ void ffx_sceneQR_setQuietZone(FfxNode node, uint8_t quietZone) {
     QRNode *qr = ffx_sceneNode_getState(node, &vtable);
     if (qr == NULL) { return; }
     qr->quietZone = quietZone;
+    ffx_sceneNode_setDirty(node);
 }
 
 color_ffxt ffx_sceneQR_getForegroundColor(FfxNode node) {
@@ -344,6 +385,7 @@ void ffx_sceneQR_setForegroundColor(FfxNode node, color_ffxt color) {
     QRNode *qr = ffx_sceneNode_getState(node, &vtable);
     if (qr == NULL) { return; }
     qr->fg = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 
@@ -357,6 +399,7 @@ void ffx_sceneQR_setBackgroundColor(FfxNode node, color_ffxt color) {
     QRNode *qr = ffx_sceneNode_getState(node, &vtable);
     if (qr == NULL) { return; }
     qr->bg = color;
+    ffx_sceneNode_setDirty(node);
 }
 
 
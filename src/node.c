@@ -21,16 +21,14 @@ FfxNode assertNode(FfxNode node) {
 }
 
 static void queueStop(FfxNode _node, int32_t startTime, uint32_t stop) {
-    Animation *animation = ffx_sceneNode_memAlloc(_node, sizeof(Animation));
-
     Node *node = _node;
+
+    Animation *animation = ffx_scene_poolAlloc(node->scene, sizeof(Animation));
     animation->node = node;
     animation->startTime = startTime;
     animation->stop = stop;
 
-    if (xQueueSendToBack(node->scene->animQueue, &animation, 0) != pdPASS) {
-        printf("FAILED TO QUEUE!\n");
-    }
+    ffx_scene_queueAnimation(node->scene, animation);
 }
 
 //////////////////////////
@@ -39,10 +37,11 @@ static void queueStop(FfxNode _node, int32_t startTime, uint32_t stop) {
 FfxNode ffx_scene_createNode(FfxScene scene, const FfxNodeVTable *vtable,
   size_t stateSize) {
 
-    Node *node = ffx_scene_memAlloc(scene, sizeof(Node) + stateSize);
+    Node *node = ffx_scene_poolAlloc(scene, sizeof(Node) + stateSize);
 
     node->vtable = vtable;
     node->scene = scene;
+    node->flags = NodeFlagDirty;
 
     return node;
 }
@@ -63,19 +62,48 @@ void* ffx_sceneNode_getState(FfxNode _node, const FfxNodeVTable *vtable) {
     return &node[1];
 }
 
+// Damages the screen presenting %%node%%
+static bool damageNode(FfxNode _node, void *arg) {
+    Node *node = _node;
+    ffx_scene_addDamage(node->scene, node->renderBounds);
+    node->renderBounds = (FfxRect){ 0 };
+    return true;
+}
+
 void ffx_sceneNode_free(FfxNode _node) {
 
     Node *node = _node;
+
+    // Damage the removed subtree (only once, from the top node)
+    if (node->parent == NULL || !(node->parent->flags & NodeFlagRemove)) {
+        ffx_sceneNode_walk(node, damageNode, NULL, NULL);
+    }
+
     node->flags |= NodeFlagRemove;
 
     // <Critical Section>
 //    animationLock(node->scene);
 
     // Clear all animations on this node; no onComplete is called
-    Animation *animation = node->scene->animationHead;
+    Animation *animation = node->animations;
     while (animation) {
-        if (animation->node == node) { animation->node = NULL; }
-        animation = animation->nextAnimation;
+        Animation *nextAnimation = animation->nextNodeAnimation;
+        animation->node = NULL;
+        animation->nextNodeAnimation = animation->prevNodeAnimation = NULL;
+        animation = nextAnimation;
+    }
+    node->animations = NULL;
+
+    // Clear any actions staggered across the parent's children which
+    // update this node
+    if (node->parent) {
+        animation = node->parent->animations;
+        for (; animation; animation = animation->nextNodeAnimation) {
+            Action *action = animation->actions;
+            for (; action; action = action->nextAction) {
+                if (action->node == node) { action->node = NULL; }
+            }
+        }
     }
 
 //    animationUnlock(node->scene);
@@ -83,7 +111,7 @@ void ffx_sceneNode_free(FfxNode _node) {
 
     node->vtable->destroyFunc(node);
 
-    ffx_sceneNode_memFree(node, node);
+    ffx_scene_poolFree(node->scene, node);
 }
 
 void ffx_sceneNode_remove(FfxNode _node) {
@@ -104,6 +132,9 @@ void ffx_sceneNode_remove(FfxNode _node) {
     // </Critical Section>
 
     node->flags |= NodeFlagRemove;
+
+    // The parent must be sequenced to reclaim the node
+    ffx_sceneNode_setDirty(node);
 }
 
 
@@ -125,6 +156,16 @@ void ffx_sceneNode_clearFlags(FfxNode _node, NodeFlag flags) {
     node->flags &= ~flags;
 }
 
+void ffx_sceneNode_setDirty(FfxNode _node) {
+    Node *node = _node;
+
+    // A dirty node's ancestors are already dirty
+    while (node && !(node->flags & NodeFlagDirty)) {
+        node->flags |= NodeFlagDirty;
+        node = node->parent;
+    }
+}
+
 
 //////////////////////////
 // VTable access
@@ -136,10 +177,137 @@ bool ffx_sceneNode_walk(FfxNode _node, FfxNodeVisitFunc enterFunc,
     return node->vtable->walkFunc(_node, enterFunc, exitFunc, arg);
 }
 
+// Re-points the renders of each node in a re-used subtree at the copies
+// of its renders. Nodes are entered in the order their renders were
+// emitted, and exited in the order of their last renders, so each
+// cursor only moves forward.
+typedef struct ReuseState {
+    uint32_t sequence;
+    Render *firstOld, *firstNew;
+    Render *lastOld, *lastNew;
+} ReuseState;
+
+static bool reuseEnter(FfxNode _node, void *_state) {
+    Node *node = _node;
+    ReuseState *state = _state;
+
+    // Hidden (or otherwise not sequenced); nothing to re-use
+    if (node->renderSequence + 1 != state->sequence) { return true; }
+
+    if (node->renderFirst) {
+        while (state->firstOld != node->renderFirst) {
+            state->firstOld = state->firstOld->nextRender;
+            state->firstNew = state->firstNew->nextRender;
+        }
+        node->renderFirst = state->firstNew;
+    }
+
+    node->renderSequence = state->sequence;
+
+    return true;
+}
+
+static bool reuseExit(FfxNode _node, void *_state) {
+    Node *node = _node;
+    ReuseState *state = _state;
+
+    if (node->renderSequence != state->sequence || !node->renderLast) {
+        return true;
+    }
+
+    while (state->lastOld != node->renderLast) {
+        state->lastOld = state->lastOld->nextRender;
+        state->lastNew = state->lastNew->nextRender;
+    }
+    node->renderLast = state->lastNew;
+
+    return true;
+}
+
 void ffx_sceneNode_sequence(FfxNode _node, FfxPoint worldPoint) {
-    if (ffx_sceneNode_getHidden(_node)) { return; }
     Node *node = _node;
+    Scene *scene = node->scene;
+
+    scene->visitNodes++;
+
+    // Clear the dirty flag first, so changes made during the sequence
+    // are picked up by the next one
+    bool dirty = node->flags & NodeFlagDirty;
+    node->flags &= ~NodeFlagDirty;
+
+    if (node->flags & NodeFlagHidden) {
+        // Just hidden; damage where it was presented
+        if (dirty) { ffx_sceneNode_walk(node, damageNode, NULL, NULL); }
+        return;
+    }
+
+    bool moved = (node->renderPosition.x != worldPoint.x ||
+      node->renderPosition.y != worldPoint.y);
+
+    // The renders from the previous sequence are still available
+    bool previous = (node->renderSequence + 1 == scene->sequence);
+
+    // Nothing changed; re-use the renders from the previous sequence
+    if (!dirty && !moved && previous) {
+
+        scene->stats.reuseCount++;
+
+        Render *first = NULL;
+        if (node->renderFirst) {
+            first = ffx_scene_copyRenders(scene, node->renderFirst,
+              node->renderLast);
+        }
+
+        // Descendants must track the copies too, so they can be re-used
+        // when a sibling changes
+        if (first || !node->renderFirst) {
+            ReuseState state = {
+                .sequence = scene->sequence,
+                .firstOld = node->renderFirst, .firstNew = first,
+                .lastOld = node->renderFirst, .lastNew = first
+            };
+            ffx_sceneNode_walk(node, reuseEnter, reuseExit, &state);
+            return;
+        }
+
+        node->renderFirst = NULL;
+        node->renderLast = NULL;
+        node->renderSequence = scene->sequence;
+        return;
+    }
+
+    Render *tail = scene->sequenceList->tail;
+    uint32_t visitNodes = scene->visitNodes;
+    scene->sequenceNodes++;
+
     node->vtable->sequenceFunc(_node, worldPoint);
+
+    // Track the renders emitted by this node and its descendants
+    Render *first = NULL, *last = scene->sequenceList->tail;
+    if (last == tail) {
+        last = NULL;
+    } else {
+        first = tail ? tail->nextRender: scene->sequenceList->head;
+    }
+
+    // Leaf node (no descendants were visited); if it may have changed
+    // damage both where it was and where it is now, unless the renders
+    // are identical. Descendants, even if all re-used, are otherwise
+    // responsible for damage.
+    if (visitNodes == scene->visitNodes && (dirty || moved)) {
+        if (!previous || !ffx_scene_compareRenders(node->renderFirst,
+          node->renderLast, first, last)) {
+            FfxRect bounds = ffx_scene_getRenderBounds(first, last);
+            ffx_scene_addDamage(scene, node->renderBounds);
+            ffx_scene_addDamage(scene, bounds);
+            node->renderBounds = bounds;
+        }
+    }
+
+    node->renderFirst = first;
+    node->renderLast = last;
+    node->renderSequence = scene->sequence;
+    node->renderPosition = worldPoint;
 }
 
 void ffx_sceneNode_dump(FfxNode _node, size_t indent) {
@@ -174,6 +342,7 @@ FfxPoint ffx_sceneNode_getPosition(FfxNode _node) {
 static void setPosition(FfxNode _node, FfxPoint position) {
     Node *node = _node;
     node->position = position;
+    ffx_sceneNode_setDirty(node);
 }
 
 void ffx_sceneNode_setPosition(FfxNode _node, FfxPoint pos) {
@@ -193,11 +362,21 @@ bool ffx_sceneNode_getHidden(FfxNode node) {
     return ffx_sceneNode_hasFlags(node, NodeFlagHidden);
 }
 
+static bool setDirty(FfxNode node, void *arg) {
+    ffx_sceneNode_setDirty(node);
+    return true;
+}
+
 void ffx_sceneNode_setHidden(FfxNode node, bool hidden) {
     if (hidden) {
         ffx_sceneNode_setFlags(node, NodeFlagHidden);
+        ffx_sceneNode_setDirty(node);
     } else {
         ffx_sceneNode_clearFlags(node, NodeFlagHidden);
+
+        // The entire subtree must be presented again
+        ffx_sceneNode_setDirty(node);
+        ffx_sceneNode_walk(node, setDirty, NULL, NULL);
     }
 }
 
@@ -258,6 +437,9 @@ static void setupAnimation(FfxNode node, FfxNodeAnimation *animation,
     animation->delay = runner->animation.delay;
     animation->duration = runner->animation.duration;
     animation->curve = runner->animation.curve;
+    animation->curveTable = runner->animation.curveTable;
+    animation->repeat = runner->animation.repeat;
+    animation->yoyo = runner->animation.yoyo;
     animation->onComplete = runner->animation.onComplete;
     animation->arg = runner->animation.arg;
 
@@ -305,8 +487,8 @@ bool ffx_sceneNode_createColorAction(FfxNode node, color_ffxt v0,
         return false;
     }
 
-    ColorState *state = ffx_sceneNode_createAction(node, sizeof(ColorState),
-      animateColor);
+    ColorState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(ColorState), animateColor);
 
     state->v0 = v0;
     state->v1 = v1;
@@ -341,8 +523,8 @@ bool ffx_sceneNode_createPointAction(FfxNode node, FfxPoint v0, FfxPoint v1,
         return false;
     }
 
-    PointState *state = ffx_sceneNode_createAction(node, sizeof(PointState),
-      animatePoint);
+    PointState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(PointState), animatePoint);
 
     state->v0 = v0;
     state->v1 = v1;
@@ -377,8 +559,8 @@ bool ffx_sceneNode_createSizeAction(FfxNode node, FfxSize v0, FfxSize v1,
         return false;
     }
 
-    SizeState *state = ffx_sceneNode_createAction(node, sizeof(SizeState),
-      animateSize);
+    SizeState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(SizeState), animateSize);
 
     state->v0 = v0;
     state->v1 = v1;
@@ -389,16 +571,263 @@ bool ffx_sceneNode_createSizeAction(FfxNode node, FfxSize v0, FfxSize v1,
 
 
 
+//////////////////////////
+// Keyframe Tracks
+
+// The timing fields common to each keyframe type
+typedef struct Keyframe {
+    fixed_ffxt time;
+    FfxCurveFunc curve;
+} Keyframe;
+
+#define KEYFRAME(frames,size,i)   \
+  ((const Keyframe*)((const uint8_t*)(frames) + (i) * (size)))
+
+static bool checkKeyframes(const void *frames, size_t frameSize,
+  size_t count) {
+
+    if (count == 0) {
+        printf("track requires keyframes\n");
+        return false;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        if (KEYFRAME(frames, frameSize, i)->time <
+          KEYFRAME(frames, frameSize, i - 1)->time) {
+            printf("track keyframes out of order\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Finds the keyframe reached next at %%t%%, returning the eased progress
+// from the previous keyframe. If %%t%% is outside the keyframes, the
+// progress is to the first or from the last keyframe.
+static fixed_ffxt findKeyframe(const void *frames, size_t frameSize,
+  size_t count, fixed_ffxt t, size_t *index) {
+
+    const Keyframe *prev = KEYFRAME(frames, frameSize, 0);
+    if (t < prev->time) {
+        *index = 0;
+        return FM_1;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        const Keyframe *frame = KEYFRAME(frames, frameSize, i);
+        if (t >= frame->time) {
+            prev = frame;
+            continue;
+        }
+
+        *index = i;
+        t = divfx(t - prev->time, frame->time - prev->time);
+        return frame->curve ? frame->curve(t): t;
+    }
+
+    *index = count - 1;
+    return FM_1;
+}
+
+
+typedef struct ColorTrackState {
+    FfxNodeActionSetColorFunc setFunc;
+    size_t count;
+    FfxColorKeyframe frames[];
+} ColorTrackState;
+
+static void animateColorTrack(FfxNode node, fixed_ffxt t, void *_state) {
+    ColorTrackState *state = _state;
+
+    size_t i;
+    t = findKeyframe(state->frames, sizeof(FfxColorKeyframe), state->count,
+      t, &i);
+
+    color_ffxt v1 = state->frames[i].value;
+    if (t == FM_1) {
+        state->setFunc(node, v1);
+        return;
+    }
+
+    color_ffxt v0 = state->frames[i - 1].value;
+    state->setFunc(node, ffx_color_lerpfx(v0, v1, t));
+}
+
+bool ffx_sceneNode_createColorTrack(FfxNode node,
+  const FfxColorKeyframe *frames, size_t count,
+  FfxNodeActionSetColorFunc setFunc) {
+
+    if (!checkKeyframes(frames, sizeof(FfxColorKeyframe), count)) {
+        return false;
+    }
+
+    if (!ffx_sceneNode_isCapturing(node)) {
+        setFunc(node, frames[count - 1].value);
+        return false;
+    }
+
+    size_t size = count * sizeof(FfxColorKeyframe);
+    ColorTrackState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(ColorTrackState) + size, animateColorTrack);
+
+    state->setFunc = setFunc;
+    state->count = count;
+    memcpy(state->frames, frames, size);
+
+    return true;
+}
+
+
+typedef struct PointTrackState {
+    FfxNodeActionSetPointFunc setFunc;
+    size_t count;
+    FfxPointKeyframe frames[];
+} PointTrackState;
+
+static void animatePointTrack(FfxNode node, fixed_ffxt t, void *_state) {
+    PointTrackState *state = _state;
+
+    size_t i;
+    t = findKeyframe(state->frames, sizeof(FfxPointKeyframe), state->count,
+      t, &i);
+
+    FfxPoint v1 = state->frames[i].value;
+    if (t == FM_1) {
+        state->setFunc(node, v1);
+        return;
+    }
+
+    FfxPoint v0 = state->frames[i - 1].value;
+    state->setFunc(node, (FfxPoint){
+        .x = v0.x + scalarfx(v1.x - v0.x, t),
+        .y = v0.y + scalarfx(v1.y - v0.y, t)
+    });
+}
+
+bool ffx_sceneNode_createPointTrack(FfxNode node,
+  const FfxPointKeyframe *frames, size_t count,
+  FfxNodeActionSetPointFunc setFunc) {
+
+    if (!checkKeyframes(frames, sizeof(FfxPointKeyframe), count)) {
+        return false;
+    }
+
+    if (!ffx_sceneNode_isCapturing(node)) {
+        setFunc(node, frames[count - 1].value);
+        return false;
+    }
+
+    size_t size = count * sizeof(FfxPointKeyframe);
+    PointTrackState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(PointTrackState) + size, animatePointTrack);
+
+    state->setFunc = setFunc;
+    state->count = count;
+    memcpy(state->frames, frames, size);
+
+    return true;
+}
+
+
+typedef struct SizeTrackState {
+    FfxNodeActionSetSizeFunc setFunc;
+    size_t count;
+    FfxSizeKeyframe frames[];
+} SizeTrackState;
+
+static void animateSizeTrack(FfxNode node, fixed_ffxt t, void *_state) {
+    SizeTrackState *state = _state;
+
+    size_t i;
+    t = findKeyframe(state->frames, sizeof(FfxSizeKeyframe), state->count,
+      t, &i);
+
+    FfxSize v1 = state->frames[i].value;
+    if (t == FM_1) {
+        state->setFunc(node, v1);
+        return;
+    }
+
+    FfxSize v0 = state->frames[i - 1].value;
+    state->setFunc(node, (FfxSize){
+        .width = v0.width + scalarfx(v1.width - v0.width, t),
+        .height = v0.height + scalarfx(v1.height - v0.height, t)
+    });
+}
+
+bool ffx_sceneNode_createSizeTrack(FfxNode node,
+  const FfxSizeKeyframe *frames, size_t count,
+  FfxNodeActionSetSizeFunc setFunc) {
+
+    if (!checkKeyframes(frames, sizeof(FfxSizeKeyframe), count)) {
+        return false;
+    }
+
+    if (!ffx_sceneNode_isCapturing(node)) {
+        setFunc(node, frames[count - 1].value);
+        return false;
+    }
+
+    size_t size = count * sizeof(FfxSizeKeyframe);
+    SizeTrackState *state = ffx_sceneNode_createKeyedAction(node, setFunc,
+      sizeof(SizeTrackState) + size, animateSizeTrack);
+
+    state->setFunc = setFunc;
+    state->count = count;
+    memcpy(state->frames, frames, size);
+
+    return true;
+}
+
+
+
 //////////////////////////
 // Animation
 
+uint32_t ffx_sceneNode_isAnimating(FfxNode _node) {
+    Node *node = _node;
+
+    uint32_t count = 0;
+
+    Animation *animation = node->animations;
+    while (animation) {
+        if (!animation->stop) { count++; }
+        animation = animation->nextNodeAnimation;
+    }
+
+    // Animations staggered across the parent's children which update
+    // this node
+    if (node->parent) {
+        animation = node->parent->animations;
+        for (; animation; animation = animation->nextNodeAnimation) {
+            if (animation->stop) { continue; }
+
+            Action *action = animation->actions;
+            for (; action; action = action->nextAction) {
+                if (action->node == node) {
+                    count++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
 bool ffx_sceneNode_isCapturing(FfxNode _node) {
     Node *node = _node;
     return node->pendingAnimation != NULL;
 }
 
-void* ffx_sceneNode_createAction(FfxNode _node, size_t stateSize,
+void* ffx_sceneNode_createAction(FfxNode node, size_t stateSize,
   FfxNodeActionFunc actionFunc) {
+    return ffx_sceneNode_createKeyedAction(node, NULL, stateSize, actionFunc);
+}
+
+void* ffx_sceneNode_createKeyedAction(FfxNode _node, const void *key,
+  size_t stateSize, FfxNodeActionFunc actionFunc) {
 
     Node *node = _node;
 
@@ -407,9 +836,27 @@ void* ffx_sceneNode_createAction(FfxNode _node, size_t stateSize,
         return NULL;
     }
 
-    Action *action = ffx_sceneNode_memAlloc(node, sizeof(Action) + stateSize);
+    // Replace any earlier action of the same property in this animation
+    if (key) {
+        Action **link = &node->pendingAnimation->actions;
+        while (*link) {
+            Action *action = *link;
+            if (action->key == key && action->node == node) {
+                *link = action->nextAction;
+                ffx_scene_poolFree(node->scene, action);
+                break;
+            }
+            link = &action->nextAction;
+        }
+    }
+
+    Action *action = ffx_scene_poolAlloc(node->scene,
+      sizeof(Action) + stateSize);
 
     action->actionFunc = actionFunc;
+    action->key = key;
+    action->node = node;
+    action->index = node->pendingAnimation->staggerIndex;
 
     // Prepend the action to the list of actions on the pending animation
     action->nextAction = node->pendingAnimation->actions;
@@ -428,7 +875,7 @@ void ffx_sceneNode_animate(FfxNode _node,
         return;
     }
 
-    Animation *animation = ffx_sceneNode_memAlloc(_node, sizeof(Animation));
+    Animation *animation = ffx_scene_poolAlloc(node->scene, sizeof(Animation));
 
     animation->node = node;
     animation->info.curve = FfxCurveLinear;
@@ -447,9 +894,48 @@ void ffx_sceneNode_animate(FfxNode _node,
 
     node->pendingAnimation = NULL;
 
-    if (xQueueSendToBack(scene->animQueue, &animation, 0) != pdPASS) {
-        printf("FAILED TO QUEUE!\n");
+    ffx_scene_queueAnimation(scene, animation);
+}
+
+void ffx_sceneGroup_animateChildren(FfxNode _node, uint32_t stagger,
+  FfxNodeAnimationSetupFunc animationsFunc, void *arg) {
+
+    Node *node = _node;
+
+    if (node->pendingAnimation != NULL) {
+        printf("already capturing animation\n");
+        return;
     }
+
+    Animation *animation = ffx_scene_poolAlloc(node->scene, sizeof(Animation));
+
+    animation->node = node;
+    animation->info.curve = FfxCurveLinear;
+    animation->stagger = stagger;
+
+    // Capture the actions of each child into the shared animation
+    Node *child = ffx_sceneGroup_getFirstChild(node);
+    while (child) {
+        if (child->pendingAnimation != NULL) {
+            printf("already capturing animation\n");
+        } else {
+            child->pendingAnimation = animation;
+            animationsFunc(child, &(animation->info), arg);
+            child->pendingAnimation = NULL;
+        }
+
+        animation->staggerIndex++;
+        child = child->nextSibling;
+    }
+
+    Scene *scene = node->scene;
+
+    if (scene->setupFunc) {
+         animation->dispatchArg = scene->setupFunc(_node, animation->info,
+           scene->initArg);
+    }
+
+    ffx_scene_queueAnimation(scene, animation);
 }
 
 void ffx_sceneNode_advanceAnimations(FfxNode node, uint32_t advance) {
@@ -42,6 +42,142 @@ void ffx_sceneNode_memFree(FfxNode _node, void *ptr) {
 }
 
 
+//////////////////////////
+// Pool
+
+static void initPool(Pool *pool, size_t slabSize) {
+    const size_t words[POOL_CLASS_COUNT] = POOL_CLASS_WORDS;
+
+    pool->slabSize = slabSize;
+    pool->task = xTaskGetCurrentTaskHandle();
+    for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+        pool->classes[i].size = words[i] * sizeof(void*);
+    }
+}
+
+// Carve a new slab into free entries for %%poolClass%%; must be called
+// on the pool task
+static bool growPoolClass(Scene *scene, PoolClass *poolClass) {
+    size_t slotSize = sizeof(PoolSlot) + poolClass->size;
+
+    size_t slabSize = scene->pool.slabSize;
+    if (slabSize < sizeof(PoolSlab) + slotSize) {
+        slabSize = sizeof(PoolSlab) + slotSize;
+    }
+
+    PoolSlab *slab = (void*)scene->allocFunc(slabSize, scene->initArg);
+    if (slab == NULL) { return false; }
+
+    slab->nextSlab = poolClass->slabHead;
+    poolClass->slabHead = slab;
+
+    size_t count = (slabSize - sizeof(PoolSlab)) / slotSize;
+    uint8_t *data = (uint8_t*)&slab[1];
+    for (size_t i = 0; i < count; i++) {
+        PoolSlot *slot = (PoolSlot*)&data[i * slotSize];
+        slot->nextFree = poolClass->freeHead;
+        poolClass->freeHead = slot;
+    }
+
+    poolClass->capacity += count;
+    __atomic_add_fetch(&scene->stats.poolSlabs, 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+static bool isPoolTask(Scene *scene) {
+    return (__atomic_load_n(&scene->pool.task, __ATOMIC_RELAXED) ==
+      xTaskGetCurrentTaskHandle());
+}
+
+void* ffx_scene_poolAlloc(Scene *scene, size_t size) {
+    if (scene->pool.slabSize == 0) { return ffx_scene_memAlloc(scene, size); }
+
+    PoolSlot *slot = NULL;
+
+    for (int i = 0; i < POOL_CLASS_COUNT && isPoolTask(scene); i++) {
+        PoolClass *poolClass = &scene->pool.classes[i];
+        if (size > poolClass->size) { continue; }
+
+        // Reclaim everything other tasks have returned in one swap
+        if (poolClass->freeHead == NULL) {
+            poolClass->freeHead = __atomic_exchange_n(&poolClass->returnHead,
+              NULL, __ATOMIC_ACQUIRE);
+        }
+
+        if (poolClass->freeHead == NULL && !growPoolClass(scene, poolClass)) {
+            printf("FAIL: could not grow pool for %d bytes\n", size);
+            return NULL;
+        }
+
+        slot = poolClass->freeHead;
+        poolClass->freeHead = slot->nextFree;
+        __atomic_add_fetch(&poolClass->used, 1, __ATOMIC_RELAXED);
+
+        slot->sizeClass = i;
+        break;
+    }
+
+    // Too large for any size class or not on the pool task; fallback
+    // onto the allocator
+    if (slot == NULL) {
+        slot = ffx_scene_memAlloc(scene, sizeof(PoolSlot) + size);
+        if (slot == NULL) { return NULL; }
+        slot->sizeClass = POOL_UNPOOLED;
+        __atomic_add_fetch(&scene->stats.poolUnpooled, 1, __ATOMIC_RELAXED);
+    }
+
+    memset(&slot[1], 0, size);
+
+    return &slot[1];
+}
+
+void ffx_scene_poolFree(Scene *scene, void *ptr) {
+    if (ptr == NULL) { return; }
+
+    if (scene->pool.slabSize == 0) {
+        ffx_scene_memFree(scene, ptr);
+        return;
+    }
+
+    PoolSlot *slot = &((PoolSlot*)ptr)[-1];
+
+    if (slot->sizeClass == POOL_UNPOOLED) {
+        ffx_scene_memFree(scene, slot);
+        return;
+    }
+
+    PoolClass *poolClass = &scene->pool.classes[slot->sizeClass];
+
+    __atomic_sub_fetch(&poolClass->used, 1, __ATOMIC_RELAXED);
+
+    if (isPoolTask(scene)) {
+        slot->nextFree = poolClass->freeHead;
+        poolClass->freeHead = slot;
+        return;
+    }
+
+    // Push-only, so there is no ABA; the pool task takes the whole
+    // stack at once
+    PoolSlot *top = __atomic_load_n(&poolClass->returnHead, __ATOMIC_RELAXED);
+    do {
+        slot->nextFree = top;
+    } while (!__atomic_compare_exchange_n(&poolClass->returnHead, &top, slot,
+      true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static void freePool(Scene *scene) {
+    for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+        PoolSlab *slab = scene->pool.classes[i].slabHead;
+        while (slab) {
+            PoolSlab *nextSlab = slab->nextSlab;
+            scene->freeFunc((void*)slab, scene->initArg);
+            slab = nextSlab;
+        }
+    }
+}
+
+
 //////////////////////////
 // Life-cycle
 
@@ -49,21 +185,69 @@ FfxScene ffx_scene_init(FfxSceneAllocFunc allocFunc,
   FfxSceneFreeFunc freeFunc, FfxSceneAnimationSetupFunc setupFunc,
   FfxSceneAnimationDispatchFunc dispatchFunc, void *initArg) {
 
+    FfxSceneConfig config = {
+        .allocFunc = allocFunc,
+        .freeFunc = freeFunc,
+        .setupFunc = setupFunc,
+        .dispatchFunc = dispatchFunc,
+        .initArg = initArg
+    };
+
+    return ffx_scene_initConfig(&config);
+}
+
+// The default clock, with the resolution of the FreeRTOS tick
+static int64_t tickClock(void *initArg) {
+    return (int64_t)xTaskGetTickCount() * portTICK_PERIOD_MS * 1000;
+}
+
+FfxScene ffx_scene_initConfig(const FfxSceneConfig *config) {
+    FfxSceneAllocFunc allocFunc = config->allocFunc;
+    FfxSceneFreeFunc freeFunc = config->freeFunc;
+    void *initArg = config->initArg;
+
     Scene *scene = (void*)allocFunc(sizeof(Scene), initArg);
     if (scene == NULL) { return NULL; }
     memset(scene, 0, sizeof(Scene));
 
     scene->allocFunc = allocFunc;
     scene->freeFunc = freeFunc;
-    scene->setupFunc = setupFunc;
-    scene->dispatchFunc = dispatchFunc;
+    scene->setupFunc = config->setupFunc;
+    scene->dispatchFunc = config->dispatchFunc;
     scene->initArg = initArg;
-    scene->tick = xTaskGetTickCount();
-    scene->root = ffx_scene_createGroup(scene);
 
-    scene->animQueue = xQueueCreateStatic(MAX_ANIMATION_BACKLOG,
-      sizeof(Animation*), scene->animQueueStorageBuffer,
-      &scene->animQueueBuffer);
+    scene->clockFunc = config->clockFunc ? config->clockFunc: tickClock;
+    scene->timeScale = FM_1;
+
+    initPool(&scene->pool, config->poolSlabSize);
+
+    scene->size.width = config->width ? config->width: DEFAULT_WIDTH;
+    scene->size.height = config->height ? config->height: DEFAULT_HEIGHT;
+    scene->fragmentHeight = config->fragmentHeight ?
+      config->fragmentHeight: DEFAULT_FRAGMENT_HEIGHT;
+    scene->stride = config->stride ? config->stride: scene->size.width;
+
+    scene->blitFunc = config->blitFunc;
+    scene->blitMask = (config->blitAlign ? config->blitAlign:
+      DEFAULT_BLIT_ALIGN) - 1;
+    if (scene->blitMask & (scene->blitMask + 1)) {
+        printf("[scene] blitAlign must be a power of 2: %d\n",
+          config->blitAlign);
+        scene->blitFunc = NULL;
+    }
+
+    scene->curveTablesEnabled = config->curveTables;
+
+    scene->batchFunc = config->batchFunc;
+    scene->pollCompletions = config->pollCompletions && !config->batchFunc;
+    scene->completionLock = xSemaphoreCreateMutexStatic(
+      &scene->completionLockData);
+
+    scene->renderLock = xSemaphoreCreateMutexStatic(&scene->renderLockData);
+    scene->renderReady = -1;
+    scene->renderActive = 0;
+
+    scene->root = ffx_scene_createGroup(scene);
 
     if (scene->root == NULL) {
         freeFunc((void*)scene, initArg);
@@ -73,11 +257,41 @@ FfxScene ffx_scene_init(FfxSceneAllocFunc allocFunc,
     return scene;
 }
 
+FfxSize ffx_scene_getSize(FfxScene _scene) {
+    Scene *scene = _scene;
+    return scene->size;
+}
+
 void ffx_scene_free(FfxScene _scene) {
     Scene *scene = _scene;
 
     // @TODO: free all children!
 
+    freePool(scene);
+
+    if (scene->anchorSlots) {
+        scene->freeFunc((void*)scene->anchorSlots, scene->initArg);
+    }
+
+    for (int i = 0; i < CURVE_TABLE_COUNT; i++) {
+        if (scene->curveTables[i] == NULL) { break; }
+        scene->freeFunc((void*)scene->curveTables[i], scene->initArg);
+    }
+
+    if (scene->completions) {
+        scene->freeFunc((void*)scene->completions, scene->initArg);
+    }
+
+    // Release the render arenas
+    for (int i = 0; i < RENDER_LIST_COUNT; i++) {
+        RenderBlock *block = scene->renderLists[i].blockHead;
+        while (block) {
+            RenderBlock *nextBlock = block->nextBlock;
+            scene->freeFunc((void*)block, scene->initArg);
+            block = nextBlock;
+        }
+    }
+
     scene->freeFunc((void*)scene, scene->initArg);
 }
 
@@ -103,95 +317,789 @@ bool ffx_scene_walk(FfxScene _scene, FfxNodeVisitFunc enterFunc,
     return true;
 }
 
-typedef struct Search {
-    FfxNodeTag tag;
-    FfxNode node;
-} Search;
+FfxNode ffx_scene_findAnchor(FfxScene _scene, FfxNodeTag tag) {
+    Scene *scene = _scene;
+    return ffx_sceneNode_findAnchor(scene->root, tag);
+}
 
-static bool checkTag(FfxNode node, void *arg) {
-    Search *search = arg;
-    if (ffx_scene_isAnchor(node) &&
-      ffx_sceneAnchor_getTag(node) == search->tag) {
-        search->node = node;
-        return false;
+size_t ffx_scene_findAnchors(FfxScene _scene, FfxNodeTag tag,
+  FfxNode *anchors, size_t count) {
+
+    Scene *scene = _scene;
+    return ffx_sceneNode_findAnchors(scene->root, tag, anchors, count);
+}
+
+//////////////////////////
+// Properties
+
+FfxNode ffx_scene_root(FfxScene _scene) {
+    Scene *scene = _scene;
+    return scene->root;
+}
+
+
+//////////////////////////
+// Render Lists
+
+void renderLock(Scene *scene) {
+    xSemaphoreTake(scene->renderLock, portMAX_DELAY);
+}
+
+void renderUnlock(Scene *scene) {
+    xSemaphoreGive(scene->renderLock);
+}
+
+// Claim a render list which is neither published nor being rendered
+static RenderList* claimSequenceList(Scene *scene) {
+    int index = 0;
+
+    renderLock(scene);
+    while (index == scene->renderReady || index == scene->renderActive) {
+        index++;
+    }
+    renderUnlock(scene);
+
+    return &scene->renderLists[index];
+}
+
+// Publish the sequenced render list; if the render pass does not
+// acquire lists explicitly, it is immediately made active
+static void publishSequenceList(Scene *scene) {
+    int index = scene->sequenceList - scene->renderLists;
+
+    renderLock(scene);
+    if (scene->renderAcquiring) {
+
+        // The render pass never acquired the previous list, so its
+        // damage must be carried forward
+        if (scene->renderReady >= 0) {
+            RenderList *dropped = &scene->renderLists[scene->renderReady];
+            for (int i = 0; i < dropped->damageCount; i++) {
+                ffx_scene_addDamage(scene, dropped->damage[i]);
+            }
+        }
+
+        scene->renderReady = index;
+    } else {
+        scene->renderActive = index;
     }
+    renderUnlock(scene);
+
+    scene->sequenceList = NULL;
+}
+
+uint32_t ffx_scene_acquireRender(FfxScene _scene) {
+    Scene *scene = _scene;
+
+    renderLock(scene);
+    scene->renderAcquiring = true;
+    if (scene->renderReady >= 0) {
+        scene->renderActive = scene->renderReady;
+        scene->renderReady = -1;
+    }
+    uint32_t index = scene->renderActive;
+    renderUnlock(scene);
+
+    return index;
+}
+
+uint32_t ffx_scene_getRenderIndex(FfxScene _scene) {
+    Scene *scene = _scene;
+
+    renderLock(scene);
+    uint32_t index = scene->renderActive;
+    renderUnlock(scene);
+
+    return index;
+}
+
+
+//////////////////////////
+// Damage
+
+FfxRect ffx_scene_unionRect(FfxRect a, FfxRect b) {
+    if (a.size.width == 0) { return b; }
+    if (b.size.width == 0) { return a; }
+
+    int32_t x0 = a.origin.x, y0 = a.origin.y;
+    int32_t x1 = x0 + a.size.width, y1 = y0 + a.size.height;
+
+    if (b.origin.x < x0) { x0 = b.origin.x; }
+    if (b.origin.y < y0) { y0 = b.origin.y; }
+    if (b.origin.x + b.size.width > x1) { x1 = b.origin.x + b.size.width; }
+    if (b.origin.y + b.size.height > y1) { y1 = b.origin.y + b.size.height; }
+
+    return (FfxRect){
+        .origin = ffx_point(x0, y0),
+        .size = ffx_size(x1 - x0, y1 - y0)
+    };
+}
+
+static uint32_t getArea(FfxRect rect) {
+    return rect.size.width * rect.size.height;
+}
+
+void ffx_scene_addDamage(Scene *scene, FfxRect rect) {
+    RenderList *renderList = scene->sequenceList;
+    if (renderList == NULL) { return; }
+
+    // Clip to the screen
+    FfxClip clip = ffx_scene_clip(rect.origin, rect.size, ffx_point(0, 0),
+      scene->size);
+    if (clip.width <= 0 || clip.height <= 0) { return; }
+
+    rect.origin = ffx_point(clip.vpX, clip.vpY);
+    rect.size = ffx_size(clip.width, clip.height);
+
+    // Already covered by an existing region
+    for (int i = 0; i < renderList->damageCount; i++) {
+        FfxRect merged = ffx_scene_unionRect(renderList->damage[i], rect);
+        if (getArea(merged) == getArea(renderList->damage[i])) { return; }
+    }
+
+    if (renderList->damageCount < MAX_DAMAGE_RECTS) {
+        renderList->damage[renderList->damageCount++] = rect;
+        return;
+    }
+
+    // Merge into the region which grows the least
+    int best = 0;
+    uint32_t bestGrowth = 0xffffffff;
+    for (int i = 0; i < MAX_DAMAGE_RECTS; i++) {
+        FfxRect merged = ffx_scene_unionRect(renderList->damage[i], rect);
+        uint32_t growth = getArea(merged) - getArea(renderList->damage[i]);
+        if (growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+
+    renderList->damage[best] = ffx_scene_unionRect(renderList->damage[best],
+      rect);
+}
+
+FfxRect ffx_scene_getDamage(FfxScene _scene) {
+    Scene *scene = _scene;
+
+    renderLock(scene);
+    RenderList *renderList = &scene->renderLists[scene->renderActive];
+    renderUnlock(scene);
+
+    FfxRect result = { 0 };
+    for (int i = 0; i < renderList->damageCount; i++) {
+        result = ffx_scene_unionRect(result, renderList->damage[i]);
+    }
+
+    return result;
+}
+
+size_t ffx_scene_getDamageRects(FfxScene _scene, FfxRect *rects,
+  size_t count) {
+
+    Scene *scene = _scene;
+
+    renderLock(scene);
+    RenderList *renderList = &scene->renderLists[scene->renderActive];
+    renderUnlock(scene);
+
+    if (count > renderList->damageCount) { count = renderList->damageCount; }
+    for (int i = 0; i < count; i++) { rects[i] = renderList->damage[i]; }
+
+    return count;
+}
+
+
+//////////////////////////
+// Render Arena
+
+// Resets %%renderList%% in O(1); all blocks are retained for re-use
+static void resetRenderList(RenderList *renderList) {
+    renderList->head = renderList->tail = NULL;
+    renderList->size = 0;
+    renderList->damageCount = 0;
+    renderList->bands = NULL;
+    renderList->bandCount = 0;
+
+    renderList->blockTail = renderList->blockHead;
+    if (renderList->blockHead) { renderList->blockHead->offset = 0; }
+}
+
+// Bump allocate %%size%% bytes from the %%renderList%% arena, only
+// hitting the allocator if no retained block has room
+static void* allocRender(Scene *scene, RenderList *renderList, size_t size) {
+    size = (size + RENDER_ALIGN - 1) & ~(RENDER_ALIGN - 1);
+
+    RenderBlock *block = renderList->blockTail;
+
+    if (block == NULL || block->offset + size > block->size) {
+
+        // The next retained block (if any)
+        RenderBlock *nextBlock = block ? block->nextBlock: NULL;
+
+        if (nextBlock == NULL || nextBlock->size < size) {
+            size_t blockSize = RENDER_BLOCK_SIZE;
+            if (size > blockSize) { blockSize = size; }
+
+            RenderBlock *newBlock = (void*)scene->allocFunc(
+              sizeof(RenderBlock) + blockSize, scene->initArg);
+            if (newBlock == NULL) { return NULL; }
+
+            newBlock->size = blockSize;
+            newBlock->data = (uint8_t*)&newBlock[1];
+
+            // Insert the new block after the current block
+            newBlock->nextBlock = nextBlock;
+            if (block) {
+                block->nextBlock = newBlock;
+            } else {
+                renderList->blockHead = newBlock;
+            }
+
+            scene->stats.renderBlocks++;
+            scene->stats.renderBlockSize += blockSize;
+
+            nextBlock = newBlock;
+        }
+
+        nextBlock->offset = 0;
+        renderList->blockTail = block = nextBlock;
+    }
+
+    void *ptr = &block->data[block->offset];
+    block->offset += size;
+    renderList->size += size;
+
+    return ptr;
+}
+
+
+// Compute the bands %%render%% overlaps, returning false if none
+static bool getRenderBands(Scene *scene, Render *render, int32_t *band0,
+  int32_t *band1) {
+
+    if (render->bounds.size.width == 0) { return false; }
+
+    int32_t y0 = render->bounds.origin.y;
+    int32_t y1 = y0 + render->bounds.size.height;
+    if (y0 < 0) { y0 = 0; }
+    if (y1 > scene->size.height) { y1 = scene->size.height; }
+    if (y0 >= y1) { return false; }
+
+    *band0 = y0 / scene->fragmentHeight;
+    *band1 = (y1 - 1) / scene->fragmentHeight;
+
     return true;
 }
 
-FfxNode ffx_sceneNode_findAnchor(FfxNode node, FfxNodeTag tag) {
-    Search search = { .tag = tag, .node = NULL };;
+// Whether %%render%% opaquely covers the entire %%band%%
+static bool isBandOccluded(Scene *scene, Render *render, int32_t band) {
+    if (!render->opaque) { return false; }
+
+    int32_t y0 = band * scene->fragmentHeight;
+    int32_t y1 = y0 + scene->fragmentHeight;
+    if (y1 > scene->size.height) { y1 = scene->size.height; }
+
+    FfxRect bounds = render->bounds;
+    return (bounds.origin.x <= 0 && bounds.origin.y <= y0 &&
+      bounds.origin.x + bounds.size.width >= scene->size.width &&
+      bounds.origin.y + bounds.size.height >= y1);
+}
+
+// Bin each render in %%renderList%% into the bands it overlaps, so each
+// fragment only visits the renders which may draw to it
+static void binRenderList(Scene *scene, RenderList *renderList) {
+    uint32_t bandCount = (scene->size.height + scene->fragmentHeight - 1) /
+      scene->fragmentHeight;
+
+    RenderBand *bands = allocRender(scene, renderList,
+      bandCount * sizeof(RenderBand));
+    if (bands == NULL) { return; }
+    memset(bands, 0, bandCount * sizeof(RenderBand));
+
+    int32_t band0, band1;
 
-    if (!ffx_sceneNode_walk(node, checkTag, NULL, &search)) {
-        return search.node;
+    // Count the renders in each band
+    Render *render = renderList->head;
+    while (render) {
+        if (getRenderBands(scene, render, &band0, &band1)) {
+            for (int32_t b = band0; b <= band1; b++) { bands[b].count++; }
+        }
+        render = render->nextRender;
     }
 
-    return NULL;
+    for (int32_t b = 0; b < bandCount; b++) {
+        if (bands[b].count == 0) { continue; }
+        bands[b].renders = allocRender(scene, renderList,
+          bands[b].count * sizeof(Render*));
+        if (bands[b].renders == NULL) { return; }
+        bands[b].count = 0;
+    }
+
+    // Populate each band, maintaining the painter's order
+    render = renderList->head;
+    while (render) {
+        if (getRenderBands(scene, render, &band0, &band1)) {
+            for (int32_t b = band0; b <= band1; b++) {
+                bands[b].renders[bands[b].count++] = render;
+            }
+        }
+        render = render->nextRender;
+    }
+
+    // Skip everything beneath the topmost render which covers each band
+    for (int32_t b = 0; b < bandCount; b++) {
+        for (int32_t i = bands[b].count - 1; i > 0; i--) {
+            if (!isBandOccluded(scene, bands[b].renders[i], b)) { continue; }
+            bands[b].renders += i;
+            bands[b].count -= i;
+            scene->stats.occludedCount += i;
+            break;
+        }
+    }
+
+    renderList->bands = bands;
+    renderList->bandCount = bandCount;
 }
 
-FfxNode ffx_scene_findAnchor(FfxScene _scene, FfxNodeTag tag) {
+
+//////////////////////////
+// Animation Queue
+
+// Push the chain %%head%% through %%tail%% (linked most recent first)
+// onto the animation queue with a single atomic operation
+static void pushAnimations(Scene *scene, Animation *head, Animation *tail) {
+    Animation *top = __atomic_load_n(&scene->animationQueue, __ATOMIC_RELAXED);
+    do {
+        tail->nextAnimation = top;
+    } while (!__atomic_compare_exchange_n(&scene->animationQueue, &top, head,
+      true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+void ffx_scene_queueAnimation(Scene *scene, Animation *animation) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    // The calling task is batching; defer until the batch ends
+    if (__atomic_load_n(&scene->batchTask, __ATOMIC_RELAXED) == task) {
+        animation->nextAnimation = scene->batchHead;
+        scene->batchHead = animation;
+        if (scene->batchTail == NULL) { scene->batchTail = animation; }
+        return;
+    }
+
+    pushAnimations(scene, animation, animation);
+}
+
+void ffx_scene_beginBatch(FfxScene _scene) {
     Scene *scene = _scene;
-    return ffx_sceneNode_findAnchor(scene->root, tag);
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    // Nested batch
+    if (__atomic_load_n(&scene->batchTask, __ATOMIC_RELAXED) == task) {
+        scene->batchDepth++;
+        return;
+    }
+
+    TaskHandle_t none = NULL;
+    if (!__atomic_compare_exchange_n(&scene->batchTask, &none, task, false,
+      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        printf("already batching on another task; not batched\n");
+        return;
+    }
+
+    scene->batchDepth = 1;
 }
 
+void ffx_scene_endBatch(FfxScene _scene) {
+    Scene *scene = _scene;
+
+    if (__atomic_load_n(&scene->batchTask, __ATOMIC_RELAXED) !=
+      xTaskGetCurrentTaskHandle()) {
+        return;
+    }
+
+    if (--scene->batchDepth) { return; }
+
+    Animation *head = scene->batchHead, *tail = scene->batchTail;
+    scene->batchHead = scene->batchTail = NULL;
+
+    __atomic_store_n(&scene->batchTask, NULL, __ATOMIC_RELEASE);
+
+    if (head) { pushAnimations(scene, head, tail); }
+}
+
+// Take every queued animation in a single swap, returning them in the
+// order they were submitted
+static Animation* drainAnimations(Scene *scene) {
+    Animation *animation = __atomic_exchange_n(&scene->animationQueue, NULL,
+      __ATOMIC_ACQUIRE);
+
+    // Reverse the stack
+    Animation *head = NULL;
+    while (animation) {
+        Animation *nextAnimation = animation->nextAnimation;
+        animation->nextAnimation = head;
+        head = animation;
+        animation = nextAnimation;
+    }
+
+    return head;
+}
+
+
 //////////////////////////
-// Properties
+// Curve Tables
+
+// Get the table sampling %%curve%%, sampling it on first use. Returns
+// NULL if tables are disabled, not worthwhile or none are available.
+static const FfxCurveTable* getCurveTable(Scene *scene, FfxCurveFunc curve) {
+    if (!scene->curveTablesEnabled || curve == FfxCurveLinear) {
+        return NULL;
+    }
+
+    for (int i = 0; i < CURVE_TABLE_COUNT; i++) {
+        FfxCurveTable *table = scene->curveTables[i];
+        if (table && table->curve == curve) { return table; }
+
+        if (table == NULL) {
+            table = (void*)scene->allocFunc(sizeof(FfxCurveTable),
+              scene->initArg);
+            if (table == NULL) { return NULL; }
+
+            ffx_curve_initTable(table, curve);
+            scene->curveTables[i] = table;
+
+            return table;
+        }
+    }
+
+    return NULL;
+}
+
+
+//////////////////////////
+// Completions
+
+// Buffer the completion of %%animation%%, if completions are batched or
+// polled. Returns false if the completion must be dispatched directly.
+static bool queueCompletion(Scene *scene, Animation *animation) {
+    if (scene->batchFunc == NULL && !scene->pollCompletions) {
+        return false;
+    }
+
+    bool queued = false;
+
+    // A batched buffer is only used by the sequencing task; a polled one
+    // is drained by any task
+    if (scene->pollCompletions) {
+        xSemaphoreTake(scene->completionLock, portMAX_DELAY);
+    }
+
+    // Grow the buffer; it is retained, so this is rare once the
+    // number of completions per frame is established
+    if (scene->completionCount == scene->completionCapacity) {
+        uint32_t capacity = scene->completionCapacity ?
+          (2 * scene->completionCapacity): COMPLETION_BUFFER_SIZE;
+
+        FfxSceneCompletion *completions = (void*)scene->allocFunc(
+          capacity * sizeof(FfxSceneCompletion), scene->initArg);
+
+        if (completions) {
+            if (scene->completions) {
+                memcpy(completions, scene->completions,
+                  scene->completionCount * sizeof(FfxSceneCompletion));
+                scene->freeFunc((void*)scene->completions, scene->initArg);
+            }
+            scene->completions = completions;
+            scene->completionCapacity = capacity;
+        }
+    }
+
+    if (scene->completionCount < scene->completionCapacity) {
+        scene->completions[scene->completionCount++] = (FfxSceneCompletion){
+            .callFunc = animation->info.onComplete,
+            .node = animation->node,
+            .stopType = animation->stop,
+            .arg = animation->info.arg,
+            .setupArg = animation->dispatchArg
+        };
+        queued = true;
+    }
+
+    if (scene->pollCompletions) { xSemaphoreGive(scene->completionLock); }
+
+    return queued;
+}
+
+// Hand the completions from this sequence to the batch function
+static void flushCompletions(Scene *scene) {
+    if (scene->batchFunc == NULL || scene->completionCount == 0) { return; }
+
+    scene->batchFunc(scene->completions, scene->completionCount,
+      scene->initArg);
+    scene->completionCount = 0;
+}
+
+size_t ffx_scene_pollCompletions(FfxScene _scene,
+  FfxSceneCompletion *completions, size_t count) {
 
-FfxNode ffx_scene_root(FfxScene _scene) {
     Scene *scene = _scene;
-    return scene->root;
+
+    if (!scene->pollCompletions) { return 0; }
+
+    xSemaphoreTake(scene->completionLock, portMAX_DELAY);
+
+    if (count > scene->completionCount) { count = scene->completionCount; }
+
+    memcpy(completions, scene->completions,
+      count * sizeof(FfxSceneCompletion));
+
+    scene->completionCount -= count;
+    memmove(scene->completions, &scene->completions[count],
+      scene->completionCount * sizeof(FfxSceneCompletion));
+
+    xSemaphoreGive(scene->completionLock);
+
+    return count;
 }
 
 
 //////////////////////////
 // Sequencing
 
+// Remove the action from the running %%animations%% (other than %%anim%%)
+// which updates the same property of the same node as %%action%%,
+// returning true if one was removed. An animation left with no actions
+// completes as stopped.
+static bool retargetAction(Scene *scene, Animation *anim, Action *action,
+  Animation *animations) {
+
+    Animation *animation = animations;
+    for (; animation; animation = animation->nextNodeAnimation) {
+        if (animation == anim || animation->stop) { continue; }
+
+        Action **link = &animation->actions;
+        while (*link && ((*link)->key != action->key ||
+          (*link)->node != action->node)) {
+            link = &(*link)->nextAction;
+        }
+        if (*link == NULL) { continue; }
+
+        Action *old = *link;
+        *link = old->nextAction;
+        ffx_scene_poolFree(scene, old);
+
+        if (animation->actions == NULL) {
+            animation->stop = FfxSceneActionStopCurrent;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// Remove the actions of the running animations which update a property
+// %%anim%% now updates. The new actions begin at the current value,
+// since it was captured before these actions ran again.
+//
+// This happens even if %%anim%% has a delay, so the property holds
+// during it; running the old action through the delay would leave the
+// property elsewhere than the captured value the new action starts at.
+//
+// An action may be on an animation of the node it updates or, if it was
+// staggered across the children of its parent, of the parent.
+static void retargetAnimations(Scene *scene, Animation *anim) {
+    for (Action *action = anim->actions; action; action = action->nextAction) {
+        Node *node = action->node;
+        if (action->key == NULL || node == NULL) { continue; }
+
+        // Each property has at most one running action
+        if (retargetAction(scene, anim, action, node->animations)) { continue; }
+        if (node->parent) {
+            retargetAction(scene, anim, action, node->parent->animations);
+        }
+    }
+}
+
+// Get the progress (after the curve) of %%animation%% at %%elapsed%%
+// microseconds after its delay; %%done%% is cleared if it is running
+static fixed_ffxt getProgress(Animation *animation, int64_t elapsed,
+  uint32_t stop, bool *done) {
+
+    int64_t duration = (int64_t)animation->info.duration * 1000;
+    uint32_t repeat = animation->info.repeat;
+    bool yoyo = animation->info.yoyo;
+
+    // The iteration and the time into it; an odd iteration of a
+    // yoyo animation runs in reverse
+    uint32_t iteration = 0;
+    int64_t phase = elapsed;
+    bool forever = (repeat == FFX_ANIMATION_REPEAT_FOREVER);
+    if (duration > 0 && elapsed >= duration &&
+      (forever || elapsed / duration <= repeat)) {
+        iteration = elapsed / duration;
+        phase = elapsed - iteration * duration;
+    }
+
+    fixed_ffxt t = FM_1;
+    if (!stop && phase < duration) {
+        t = (phase << 16) / duration;
+        if (t > FM_1) { t = FM_1; }
+        *done = false;
+    } else {
+        // Finish at the end of the last iteration
+        if (!forever) { iteration = repeat; }
+    }
+
+    if (yoyo && (iteration & 1)) { t = FM_1 - t; }
+
+    if (animation->curveTable) {
+        return ffx_curve_evalTable(animation->curveTable, t);
+    }
+
+    return animation->info.curve(t);
+}
+
+// Add %%anim%% to the running animations of its node
+static void addAnimation(Scene *scene, Animation *anim) {
+    Node *node = anim->node;
+    anim->prevNodeAnimation = NULL;
+    anim->nextNodeAnimation = node->animations;
+    if (node->animations) { node->animations->prevNodeAnimation = anim; }
+    node->animations = anim;
+
+    if (scene->animationHead == NULL) {
+        scene->animationHead = scene->animationTail = anim;
+    } else {
+        scene->animationTail->nextAnimation = anim;
+        scene->animationTail = anim;
+    }
+}
+
+// Apply the stop or advance request %%anim%% to the actions staggered
+// across the children of a parent which update the node of %%anim%%. A
+// stop removes the actions (after running them to the end, if final),
+// while an advance moves them to a new animation on the node, so its
+// siblings are unaffected. An animation left with no actions completes
+// as stopped.
+static void stopStaggered(Scene *scene, Animation *anim) {
+    Node *node = anim->node;
+    if (node->parent == NULL) { return; }
+
+    Animation *animation = node->parent->animations;
+    for (; animation; animation = animation->nextNodeAnimation) {
+        if (animation->stop) { continue; }
+
+        Animation *detached = NULL;
+
+        Action **link = &animation->actions;
+        while (*link) {
+            Action *action = *link;
+            if (action->node != node) {
+                link = &action->nextAction;
+                continue;
+            }
+
+            *link = action->nextAction;
+            action->nextAction = NULL;
+
+            if (anim->stop == STOP_ADVANCE) {
+                if (detached == NULL) {
+                    detached = ffx_scene_poolAlloc(scene, sizeof(Animation));
+                    if (detached == NULL) {
+                        // Leave the actions with their siblings
+                        action->nextAction = *link;
+                        *link = action;
+                        break;
+                    }
+
+                    // Begins when its index would have (and is advanced
+                    // along with the node's own animations); the
+                    // completion remains with the shared animation
+                    detached->node = node;
+                    detached->info = animation->info;
+                    detached->info.onComplete = NULL;
+                    detached->curveTable = animation->curveTable;
+                    detached->startTime = animation->startTime +
+                      (int64_t)action->index * animation->stagger * 1000;
+                }
+
+                action->index = 0;
+                action->nextAction = detached->actions;
+                detached->actions = action;
+                continue;
+            }
+
+            if (anim->stop == FfxSceneActionStopFinal) {
+                int64_t offset = scene->time - animation->startTime -
+                  (int64_t)animation->info.delay * 1000 -
+                  (int64_t)action->index * animation->stagger * 1000;
+                bool done = true;
+                fixed_ffxt t = getProgress(animation, offset, anim->stop,
+                  &done);
+                action->actionFunc(node, t, &action[1]);
+            }
+
+            ffx_scene_poolFree(scene, action);
+        }
+
+        if (animation->actions == NULL) {
+            animation->stop = FfxSceneActionStopCurrent;
+        }
+
+        if (detached) { addAnimation(scene, detached); }
+    }
+}
+
 static void updateAnimations(Scene *scene) {
-    int32_t now = scene->tick;
+    int64_t now = scene->time;
 
     // Add any queued animation actions
-    while (true) {
+    Animation *queued = drainAnimations(scene);
+    while (queued) {
+
+        Animation *anim = queued;
+        queued = anim->nextAnimation;
+        anim->nextAnimation = NULL;
 
-        Animation *anim = NULL;
-        BaseType_t result = xQueueReceive(scene->animQueue, &anim, 0);
-        if (result != pdPASS) { break; }
+        // Actions on this node staggered across its parent's children
+        if (anim->stop) { stopStaggered(scene, anim); }
 
         // Queued Advance Animations
         if (anim->stop == STOP_ADVANCE) {
-            Animation *animation = scene->animationHead;
+            Animation *animation = anim->node->animations;
             while (animation) {
-                if (animation->node == anim->node && !animation->stop) {
-                    animation->startTime -= anim->startTime;;
+                if (!animation->stop) {
+                    animation->startTime -= anim->startTime * 1000;
                 }
-                animation = animation->nextAnimation;
+                animation = animation->nextNodeAnimation;
             }
-            ffx_scene_memFree(scene, animation);
+            ffx_scene_poolFree(scene, anim);
             continue;
         }
 
         // Queued Stop Animations
         if (anim->stop) {
-            Animation *animation = scene->animationHead;
+            Animation *animation = anim->node->animations;
             while (animation) {
-                if (animation->node == anim->node && !animation->stop) {
-                    animation->stop = anim->stop;
-                }
-                animation = animation->nextAnimation;
+                if (!animation->stop) { animation->stop = anim->stop; }
+                animation = animation->nextNodeAnimation;
             }
-            ffx_scene_memFree(scene, animation);
+            ffx_scene_poolFree(scene, anim);
             continue;
         }
 
         // Queued Animation
 
         anim->startTime = now;
-
-        // Add the new animation to the animation list
-        if (scene->animationHead == NULL) {
-            scene->animationHead = scene->animationTail = anim;
-        } else {
-            scene->animationTail->nextAnimation = anim;
-            scene->animationTail = anim;
+        anim->curveTable = anim->info.curveTable;
+        if (anim->curveTable == NULL) {
+            anim->curveTable = getCurveTable(scene, anim->info.curve);
         }
+
+        addAnimation(scene, anim);
+
+        retargetAnimations(scene, anim);
     }
 
 
@@ -210,11 +1118,11 @@ static void updateAnimations(Scene *scene) {
 
         bool done = true;
 
-        // Make sure we cast this to a signed value or the below "common"
-        // type for the comparison will be unsigned. Since startTime can
-        // be negative in the case of advanceAnimatin, we need to do all
-        // maths in signed-land.
-        int32_t delay = animation->info.delay;
+        // All times are in microseconds. Make sure we cast this to a signed
+        // value or the below "common" type for the comparison will be
+        // unsigned. Since startTime can be negative in the case of
+        // advanceAnimatin, we need to do all maths in signed-land.
+        int64_t delay = (int64_t)animation->info.delay * 1000;
 
         if (animation->node == NULL || animation->node->flags & NodeFlagRemove) {
             // Node was removed
@@ -224,32 +1132,52 @@ static void updateAnimations(Scene *scene) {
             done = false;
 
         } else if (animation->actions && stop != FfxSceneActionStopCurrent) {
-            done = false;
-
-            int32_t n = now - animation->info.delay;
+            int64_t elapsed = now - animation->startTime - delay;
+            int64_t stagger = (int64_t)animation->stagger * 1000;
 
-            int32_t duration = animation->info.duration;
-            int32_t endTime = animation->startTime + duration;
-
-            fixed_ffxt t = FM_1;
-            if (!stop && n < endTime) {
-                t = FM_1 - (tofx(endTime - n) / duration);
-                if (t > FM_1) { t = FM_1; }
-            } else {
-                done = true;
-            }
-
-            t = animation->info.curve(t);
+            // Each staggered index starts later; the actions of an index
+            // are adjacent, so its progress is only computed once
+            uint32_t index = UINT32_MAX;
+            bool started = false;
+            fixed_ffxt t = 0;
 
             Action *action = animation->actions;
             while (action) {
-                //printf("action: %p\n", action);
-                action->actionFunc(animation->node, t, &action[1]);
+                if (action->index != index) {
+                    index = action->index;
+                    int64_t offset = elapsed - index * stagger;
+                    started = (stop || offset > 0);
+                    if (started) {
+                        t = getProgress(animation, offset, stop, &done);
+                    } else {
+                        done = false;
+                    }
+                }
+
+                if (started && action->node) {
+                    action->actionFunc(action->node, t, &action[1]);
+                }
                 action = action->nextAction;
             }
         }
 
         if (done || stop) {
+
+            // Remove from the node's animations
+            Node *node = animation->node;
+            if (node) {
+                if (animation->prevNodeAnimation) {
+                    animation->prevNodeAnimation->nextNodeAnimation =
+                      animation->nextNodeAnimation;
+                } else {
+                    node->animations = animation->nextNodeAnimation;
+                }
+                if (animation->nextNodeAnimation) {
+                    animation->nextNodeAnimation->prevNodeAnimation =
+                      animation->prevNodeAnimation;
+                }
+            }
+
             if (prevAnimation == NULL) {
                 scene->animationHead = nextAnimation;
             } else {
@@ -283,8 +1211,9 @@ static void updateAnimations(Scene *scene) {
 
         FfxSceneActionStop stop = animation->stop;
 
-        // Call any completion callback
-        if (animation->info.onComplete) {
+        // Call (or buffer) any completion callback
+        if (animation->info.onComplete &&
+          !queueCompletion(scene, animation)) {
             if (scene->dispatchFunc) {
                 scene->dispatchFunc(animation->dispatchArg,
                   animation->info.onComplete, animation->node, stop,
@@ -299,48 +1228,171 @@ static void updateAnimations(Scene *scene) {
         Action *action = animation->actions;
         while (action) {
             Action *nextAction = action->nextAction;
-            ffx_scene_memFree(scene, action);
+            ffx_scene_poolFree(scene, action);
             action = nextAction;
         }
 
         // Free the animation
-        ffx_scene_memFree(scene, animation);
+        ffx_scene_poolFree(scene, animation);
 
         animation = nextAnimation;
     }
 }
 
-void ffx_scene_sequence(FfxScene _scene) {
+void ffx_scene_setTimeScale(FfxScene _scene, fixed_ffxt timeScale) {
     Scene *scene = _scene;
+    scene->timeScale = (timeScale > 0) ? timeScale: 0;
+}
 
-    scene->stats.seqCount++;
+fixed_ffxt ffx_scene_getTimeScale(FfxScene _scene) {
+    Scene *scene = _scene;
+    return scene->timeScale;
+}
+
+bool ffx_scene_sequence(FfxScene _scene) {
+    Scene *scene = _scene;
+    return ffx_scene_sequenceAt(scene, scene->clockFunc(scene->initArg));
+}
+
+bool ffx_scene_sequenceAt(FfxScene _scene, int64_t now) {
+    Scene *scene = _scene;
+
+    // The pool belongs to the sequencing task, which frees almost
+    // every entry; sequencing moving tasks rebinds it
+    if (!isPoolTask(scene)) {
+        __atomic_store_n(&scene->pool.task, xTaskGetCurrentTaskHandle(),
+          __ATOMIC_RELAXED);
+    }
+
+    // Advance the scene time by the (scaled) time elapsed on the clock;
+    // the first sequence defines the clock origin
+    if (scene->sequence > 0 && now > scene->clockTime) {
+        scene->time += ((now - scene->clockTime) * scene->timeScale) >> 16;
+    }
+    scene->clockTime = now;
 
     // Update all animations
     updateAnimations(scene);
 
-    // Delete the last render data
-    if (scene->renderHead) {
-        Render *render = scene->renderHead;
-        scene->renderHead = scene->renderTail = NULL;
-
-        while (render) {
-            Render *nextRender = render->nextRender;
-            ffx_scene_memFree(scene, render);
-            render = nextRender;
-        }
+    // Nothing changed since the last sequence; its render list (which
+    // is still the most recently published) remains current
+    if (scene->sequence > 0 && !(scene->root->flags & NodeFlagDirty)) {
+        scene->stats.idleCount++;
+        flushCompletions(scene);
+        return false;
     }
 
-    scene->tick = xTaskGetTickCount();
+    scene->stats.seqCount++;
+    scene->sequence++;
+
+    // Recycle a free render list; the arena blocks are retained
+    RenderList *renderList = claimSequenceList(scene);
+    resetRenderList(renderList);
+    scene->sequenceList = renderList;
+
+    // Nothing has been presented yet
+    if (scene->sequence == 1) {
+        ffx_scene_addDamage(scene, (FfxRect){
+            .size = scene->size
+        });
+    }
 
     // Sequence all the nodes
     ffx_sceneNode_sequence(scene->root, ffx_point(0, 0));
+
+    binRenderList(scene, renderList);
+
+    if (renderList->size > scene->stats.renderHighWater) {
+        scene->stats.renderHighWater = renderList->size;
+    }
+
+    publishSequenceList(scene);
+
+    // Includes any damage carried forward from a list never acquired
+    bool changed = (renderList->damageCount > 0);
+
+    flushCompletions(scene);
+
+    return changed;
+}
+
+bool ffx_scene_getDeadline(FfxScene _scene, int64_t *deadline) {
+    Scene *scene = _scene;
+
+    // A change or submission is waiting to be sequenced
+    if (scene->sequence == 0 || (scene->root->flags & NodeFlagDirty) ||
+      __atomic_load_n(&scene->animationQueue, __ATOMIC_ACQUIRE)) {
+        *deadline = scene->clockTime;
+        return true;
+    }
+
+    // The earliest (scene) time an animation begins to update
+    bool found = false;
+    int64_t next = 0;
+
+    Animation *animation = scene->animationHead;
+    while (animation) {
+        int64_t start = animation->startTime +
+          (int64_t)animation->info.delay * 1000;
+
+        // Running (or stopping); it needs every sequence
+        if (animation->stop || start < scene->time) {
+            *deadline = scene->clockTime;
+            return true;
+        }
+
+        if (!found || start < next) { next = start; }
+        found = true;
+
+        animation = animation->nextAnimation;
+    }
+
+    if (!found || scene->timeScale == 0) { return false; }
+
+    // Convert to clock time, rounding up so the delay has elapsed
+    int64_t wait = ((next - scene->time + 1) << 16) + scene->timeScale - 1;
+    *deadline = scene->clockTime + wait / scene->timeScale;
+
+    return true;
 }
 
 
 //////////////////////////
 // Rendering
 
-//#define RENDER_SIZE         (512)
+void ffx_scene_blit(FfxScene _scene, void *dst, const void *src,
+  size_t length) {
+
+    Scene *scene = _scene;
+    uintptr_t mask = scene->blitMask;
+
+    // The source and destination can only be aligned together if they
+    // share the same misalignment
+    if (scene->blitFunc == NULL || (((uintptr_t)dst ^ (uintptr_t)src) & mask)) {
+        memcpy(dst, src, length);
+        return;
+    }
+
+    size_t head = (-(uintptr_t)dst) & mask;
+    if (head >= length) {
+        memcpy(dst, src, length);
+        return;
+    }
+
+    size_t body = (length - head) & ~mask;
+
+    uint8_t *output = dst;
+    const uint8_t *input = src;
+
+    if (head) { memcpy(output, input, head); }
+    if (body) {
+        scene->blitFunc(&output[head], &input[head], body, scene->initArg);
+    }
+    if (head + body < length) {
+        memcpy(&output[head + body], &input[head + body],
+          length - head - body);
+    }
+}
 
 void* ffx_scene_createRender(FfxNode _node, size_t stateSize) {
 
@@ -354,29 +1406,147 @@ void* ffx_scene_createRender(FfxNode _node, size_t stateSize) {
     if (size > scene->stats.maxRenderSize) { scene->stats.maxRenderSize = size; }
     if (size < scene->stats.minRenderSize) { scene->stats.minRenderSize = size; }
 
-    Render *render = ffx_sceneNode_memAlloc(_node, size);
+    RenderList *renderList = scene->sequenceList;
+    if (renderList == NULL) {
+        printf("cannot create render; not sequencing\n");
+        return NULL;
+    }
+
+    Render *render = allocRender(scene, renderList, size);
+    if (render == NULL) {
+        printf("FAIL: could not allocate render %d bytes\n", size);
+        return NULL;
+    }
+    memset(render, 0, size);
 
-    if (scene->renderHead == NULL) {
-        scene->renderHead = scene->renderTail = render;
+    if (renderList->head == NULL) {
+        renderList->head = renderList->tail = render;
     } else {
-        scene->renderTail->nextRender = render;
-        scene->renderTail = render;
+        renderList->tail->nextRender = render;
+        renderList->tail = render;
     }
 
     render->renderFunc = node->vtable->renderFunc;
+    render->size = size;
+    render->bounds.size = scene->size;
 
     return &render[1];
 }
 
+void ffx_scene_setRenderBounds(void *_render, FfxPoint origin, FfxSize size) {
+    Render *render = &((Render*)_render)[-1];
+    render->bounds.origin = origin;
+    render->bounds.size = size;
+}
+
+void ffx_scene_setRenderOpaque(void *_render, bool opaque) {
+    Render *render = &((Render*)_render)[-1];
+    render->opaque = opaque;
+}
+
+FfxRect ffx_scene_getRenderBounds(Render *first, Render *last) {
+    FfxRect result = { 0 };
+
+    Render *render = first;
+    while (render) {
+        result = ffx_scene_unionRect(result, render->bounds);
+        if (render == last) { break; }
+        render = render->nextRender;
+    }
+
+    return result;
+}
+
+bool ffx_scene_compareRenders(Render *first0, Render *last0, Render *first1,
+  Render *last1) {
+
+    // Skip the list linkage; everything else must match
+    const size_t offset = offsetof(Render, renderFunc);
+
+    Render *render0 = first0, *render1 = first1;
+    while (render0 && render1) {
+        if (render0->size != render1->size) { return false; }
+        if (memcmp((uint8_t*)render0 + offset, (uint8_t*)render1 + offset,
+          render0->size - offset)) {
+            return false;
+        }
+
+        if (render0 == last0 || render1 == last1) {
+            return (render0 == last0 && render1 == last1);
+        }
+
+        render0 = render0->nextRender;
+        render1 = render1->nextRender;
+    }
+
+    return (render0 == NULL && render1 == NULL);
+}
+
+Render* ffx_scene_copyRenders(Scene *scene, Render *first, Render *last) {
+    RenderList *renderList = scene->sequenceList;
+
+    Render *result = NULL;
+
+    Render *render = first;
+    while (render) {
+        Render *copy = allocRender(scene, renderList, render->size);
+        if (copy == NULL) {
+            printf("FAIL: could not allocate render %d bytes\n", render->size);
+            return NULL;
+        }
+
+        memcpy(copy, render, render->size);
+        copy->nextRender = NULL;
+
+        if (renderList->head == NULL) {
+            renderList->head = renderList->tail = copy;
+        } else {
+            renderList->tail->nextRender = copy;
+            renderList->tail = copy;
+        }
+
+        if (result == NULL) { result = copy; }
+
+        scene->stats.reuseRenderCount++;
+
+        if (render == last) { break; }
+        render = render->nextRender;
+    }
+
+    return result;
+}
+
 
 void ffx_scene_render(FfxScene _scene, uint16_t *fragment, FfxPoint origin,
   FfxSize size) {
 
     Scene *scene = _scene;
 
-    Render *render = scene->renderHead;
+    // The active list cannot be recycled until the next acquire, which
+    // is made by the render pass itself, so no lock is held while drawing
+    renderLock(scene);
+    RenderList *renderList = &scene->renderLists[scene->renderActive];
+    renderUnlock(scene);
+
+    // The viewport lies within a single band; only visit its renders
+    int32_t band = origin.y / scene->fragmentHeight;
+    if (renderList->bands && origin.y >= 0 && band < renderList->bandCount &&
+      origin.y + size.height <= (band + 1) * scene->fragmentHeight) {
+
+        RenderBand *renderBand = &renderList->bands[band];
+        for (uint32_t i = 0; i < renderBand->count; i++) {
+            Render *render = renderBand->renders[i];
+            render->renderFunc(&render[1], fragment, scene->stride, origin,
+              size);
+        }
+
+        return;
+    }
+
+    Render *render = renderList->head;
     while (render) {
-        render->renderFunc(&render[1], fragment, origin, size);
+        render->renderFunc(&render[1], fragment, scene->stride, origin,
+          size);
         render = render->nextRender;
     }
 }
@@ -393,20 +1563,53 @@ void ffx_scene_dump(FfxScene _scene) {
 void ffx_scene_dumpStats(FfxScene _scene) {
     Scene *scene = _scene;
 
-    printf("Scene Stats: seqCount=%ld\n", scene->stats.seqCount);
+    printf("Scene Stats: seqCount=%ld idleCount=%ld\n", scene->stats.seqCount,
+      scene->stats.idleCount);
+
+    printf("  Render Arena: blocks=%ld blockSize=%ld highWater=%ld\n",
+      scene->stats.renderBlocks, scene->stats.renderBlockSize,
+      scene->stats.renderHighWater);
+
+    if (scene->pool.slabSize) {
+        printf("  Pool: slabs=%ld unpooled=%ld\n", scene->stats.poolSlabs,
+          scene->stats.poolUnpooled);
+        for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+            PoolClass *poolClass = &scene->pool.classes[i];
+            printf("    class=%d size=%d used=%ld capacity=%ld\n", i,
+              poolClass->size, poolClass->used, poolClass->capacity);
+        }
+    }
+
+    printf("  Render Reuse: nodes=%ld renders=%ld\n", scene->stats.reuseCount,
+      scene->stats.reuseRenderCount);
+
+    printf("  Render Occlusion: culled=%ld\n", scene->stats.occludedCount);
+
+    // Idle sequences and re-used renders may leave either count at 0
+    uint32_t renderCount = scene->stats.renderCount;
+    uint32_t seqCount = scene->stats.seqCount;
 
     printf("  Render Alloc: count=%ld min=%ld max=%ld avg=%ld avgPerFrame=%ld\n",
       scene->stats.renderCount,
       scene->stats.minRenderSize, scene->stats.maxRenderSize,
-      scene->stats.totalRenderSize / scene->stats.renderCount,
-      scene->stats.totalRenderSize / scene->stats.seqCount
+      renderCount ? scene->stats.totalRenderSize / renderCount: 0,
+      seqCount ? scene->stats.totalRenderSize / seqCount: 0
       );
 
     scene->stats.seqCount = 0;;
+    scene->stats.idleCount = 0;
 
     scene->stats.renderCount = 0;;
     scene->stats.minRenderSize = 0;;
     scene->stats.maxRenderSize = 0;;
     scene->stats.totalRenderSize = 0;;
+
+    scene->stats.reuseCount = 0;
+    scene->stats.reuseRenderCount = 0;
+
+    scene->stats.occludedCount = 0;
+
+    // The arena blocks are retained; only the high-water mark is reset
+    scene->stats.renderHighWater = 0;
 }
 
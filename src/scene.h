@@ -7,11 +7,49 @@ extern "C" {
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "firefly-scene-private.h"
 
 
-#define MAX_ANIMATION_BACKLOG (32)
+// The default capacity of each block in the render arena
+#define RENDER_BLOCK_SIZE     (2048)
+
+// The number of render lists; one may be rendered while one holds
+// the most recently published frame and another is being sequenced
+#define RENDER_LIST_COUNT     (3)
+
+// The default display geometry
+#define DEFAULT_WIDTH         (240)
+#define DEFAULT_HEIGHT        (240)
+#define DEFAULT_FRAGMENT_HEIGHT  (24)
+
+// The initial capacity of the anchor index (must be a power of 2)
+#define ANCHOR_INDEX_SIZE     (16)
+
+// The maximum number of distinct curves sampled into tables; any others
+// are evaluated directly
+#define CURVE_TABLE_COUNT     (8)
+
+// The default alignment required by the blitFunc
+#define DEFAULT_BLIT_ALIGN    (4)
+
+// The initial capacity of the completion buffer
+#define COMPLETION_BUFFER_SIZE   (16)
+
+// The maximum number of damage regions tracked per render list; any
+// additional regions are merged
+#define MAX_DAMAGE_RECTS      (8)
+
+// All render allocations are rounded up to keep the state aligned
+#define RENDER_ALIGN          (sizeof(void*))
+
+// The pool size classes, in pointer-sized words of payload
+#define POOL_CLASS_COUNT      (5)
+#define POOL_CLASS_WORDS      { 8, 12, 16, 24, 32 }
+
+// Marks a pool allocation which was too large for any size class
+#define POOL_UNPOOLED         ((uintptr_t)0xff)
 
 #define STOP_ADVANCE          (0xff01)
 #define STOP_FREE             (0xff02)
@@ -34,6 +72,10 @@ typedef enum NodeFlag {
 //    NodeFlagCapturing       = (1 << 8),
     NodeFlagHidden         = (1 << 4),
 
+    // Node (or a descendant) has changed since it was last sequenced,
+    // so its renders from the last sequence cannot be re-used
+    NodeFlagDirty          = (1 << 5),
+
 } NodeFlag;
 
 
@@ -45,15 +87,42 @@ void ffx_sceneNode_clearFlags(FfxNode node, NodeFlag flags);
 typedef struct Action {
     struct Action *nextAction;
     FfxNodeActionFunc actionFunc;
+
+    // The property updated (i.e. its setter); a newer action on the
+    // same node with the same key replaces this one. May be NULL.
+    const void *key;
+
+    // The node updated, which is the animation node unless staggered
+    // across a group's children (NULL if it was freed), and its index
+    // among them
+    struct Node *node;
+    uint32_t index;
+
     // Action State here
 } Action;
 
 typedef struct Animation {
     struct Animation *nextAnimation;
+
+    // The running animations of the same node
+    struct Animation *nextNodeAnimation;
+    struct Animation *prevNodeAnimation;
+
     void *dispatchArg;
     Action *actions;
     struct Node *node;
-    int32_t startTime;
+
+    // The compiled or sampled curve table, if any
+    const FfxCurveTable *curveTable;
+
+    // The delay (in milliseconds) between each action index; while
+    // capturing, the index of the node being captured
+    uint32_t stagger;
+    uint32_t staggerIndex;
+
+    // The scene time the animation began (in microseconds); for an
+    // advance request, the advance (in milliseconds)
+    int64_t startTime;
     uint32_t stop;
     FfxNodeAnimation info;
 } Animation;
@@ -62,6 +131,16 @@ typedef struct Animation {
 typedef struct Render {
     struct Render *nextRender;
     FfxNodeRenderFunc renderFunc;
+
+    // The size of the render, including the state
+    size_t size;
+
+    // The region of the screen this render may draw to
+    FfxRect bounds;
+
+    // Whether the render covers every pixel of its bounds opaquely
+    bool opaque;
+
     // Render State here
 } Render;
 
@@ -70,6 +149,7 @@ typedef struct Node {
     const FfxNodeVTable* vtable;
 
     struct Scene *scene;
+    struct Node *parent;
     FfxPoint position;
     uint32_t flags;
     FfxNode nextSibling;
@@ -77,25 +157,114 @@ typedef struct Node {
     // The current animation being populated with actions
     Animation *pendingAnimation;
 
+    // The running animations on this node
+    Animation *animations;
+
+    // The renders (including any descendants) emitted by this node,
+    // the sequence they were emitted in and the world position used
+    Render *renderFirst;
+    Render *renderLast;
+    uint32_t renderSequence;
+    FfxPoint renderPosition;
+
+    // The bounds of the renders emitted directly by this node (i.e.
+    // excluding descendants), currently presented on the screen
+    FfxRect renderBounds;
+
     // Node State here
 } Node;
 
+// Each pool entry is prefixed with a slot header, which holds the
+// size class while allocated and links the free list while free.
+typedef union PoolSlot {
+    union PoolSlot *nextFree;
+    uintptr_t sizeClass;
+} PoolSlot;
+
+typedef struct PoolSlab {
+    struct PoolSlab *nextSlab;
+} PoolSlab;
+
+typedef struct PoolClass {
+    // The payload size of each entry
+    size_t size;
+
+    // Owned by the pool task; only it pops, pushes or grows these
+    PoolSlot *freeHead;
+    PoolSlab *slabHead;
+
+    // Entries freed on any other task are pushed here lock-free and
+    // reclaimed by the pool task once its free list runs dry
+    PoolSlot *returnHead;
+
+    uint32_t used, capacity;
+} PoolClass;
+
+typedef struct Pool {
+    // If 0, the pool is disabled
+    size_t slabSize;
+
+    // The task which owns the free lists (i.e. the sequencing task);
+    // allocations on any other task fallback onto the allocator
+    TaskHandle_t task;
+
+    PoolClass classes[POOL_CLASS_COUNT];
+} Pool;
+
 typedef struct Stats {
-    uint32_t seqCount;
+    uint32_t seqCount, idleCount;
     uint32_t renderCount, minRenderSize, maxRenderSize, totalRenderSize;
+    uint32_t renderBlocks, renderBlockSize, renderHighWater;
+    uint32_t poolSlabs, poolUnpooled;
+    uint32_t reuseCount, reuseRenderCount;
+    uint32_t occludedCount;
 } Stats;
 
+// A chunk of memory in the render arena. Blocks are never released
+// between sequences; the data follows the header in the same allocation.
 typedef struct RenderBlock {
     struct RenderBlock *nextBlock;
     size_t offset;
+    size_t size;
     uint8_t *data;
 } RenderBlock;
 
+// An entry in the open-addressing anchor index; the anchor is the most
+// recently indexed anchor with the tag, which links to the others. An
+// empty slot has a NULL anchor.
+typedef struct AnchorSlot {
+    FfxNodeTag tag;
+    struct Node *anchor;
+} AnchorSlot;
+
+// The renders (in painter's order) which overlap a horizontal band
+typedef struct RenderBand {
+    Render **renders;
+    uint32_t count;
+} RenderBand;
+
+// A render list is backed by a bump arena of RenderBlocks, which is
+// reset (but retained) at the start of each sequence.
+//
+// The blockTail is the block currently being allocated from, which
+// may be followed by additional retained blocks from earlier sequences.
 typedef struct RenderList {
     RenderBlock *blockHead;
     RenderBlock *blockTail;
     Render *head;
     Render *tail;
+
+    // The number of bytes allocated since the last reset
+    size_t size;
+
+    // The regions changed since the previously published render list
+    FfxRect damage[MAX_DAMAGE_RECTS];
+    uint32_t damageCount;
+
+    // The renders binned by band (allocated from the arena); NULL if
+    // binning failed
+    RenderBand *bands;
+    uint32_t bandCount;
 } RenderList;
 
 
@@ -107,28 +276,96 @@ typedef struct Scene {
     FfxSceneAnimationDispatchFunc dispatchFunc;
     void *initArg;
 
+    // Pooled allocator for nodes, actions and animations
+    Pool pool;
+
+    // The display geometry
+    FfxSize size;
+    uint16_t fragmentHeight;
+    uint16_t stride;
+
+    // The copy function for image rows (may be NULL) and the alignment
+    // it requires, less one
+    FfxSceneBlitFunc blitFunc;
+    uintptr_t blitMask;
+
+    // Sampled curves; only used if enabled
+    bool curveTablesEnabled;
+    FfxCurveTable *curveTables[CURVE_TABLE_COUNT];
+
+    // Anchors indexed by tag (linear probing); see node-anchor.c
+    AnchorSlot *anchorSlots;
+    uint32_t anchorCapacity;
+    uint32_t anchorCount;
+
     // The root (group) node
     Node *root;
 
     Stats stats;
 
-    // Gloabl tick
-    // Guarded by animationLock ??
-    int32_t tick;
+    // The clock and its reading at the last sequence (in microseconds)
+    FfxSceneClockFunc clockFunc;
+    int64_t clockTime;
+
+    // The scene time animations are run against (in microseconds), which
+    // advances with the clock scaled by timeScale
+    int64_t time;
+    fixed_ffxt timeScale;
+
+    // The number of sequences performed; renders emitted in the
+    // previous sequence can be re-used by clean nodes
+    uint32_t sequence;
+
+    // The number of nodes sequenced (i.e. not re-used)
+    uint32_t sequenceNodes;
+
+    // The number of nodes visited, including re-used and hidden nodes;
+    // used to detect leaf nodes
+    uint32_t visitNodes;
+
+    // The render lists (head and tail may be null)
+    RenderList renderLists[RENDER_LIST_COUNT];
 
-    // The head and tail of the current render list (may be null)
+    // The render list being populated; only accessed while sequencing
+    RenderList *sequenceList;
+
+    // The most recently published render list (or -1 if none is
+    // pending) and the render list in use by the render pass
     // Guarded by renderLock
-    Render *renderHead;
-    Render *renderTail;
+    int8_t renderReady;
+    int8_t renderActive;
+
+    // Whether the render pass acquires render lists explicitly
+    bool renderAcquiring;
 
     // The head and tail of the animation list (may be null)
     // Guarded by animationLock
     Animation *animationHead;
     Animation *animationTail;
 
-    StaticQueue_t animQueueBuffer;
-    uint8_t animQueueStorageBuffer[MAX_ANIMATION_BACKLOG * sizeof(Animation*)];
-    QueueHandle_t animQueue;
+    // Animations (and stop and advance requests) submitted but not yet
+    // drained by updateAnimations; a lock-free intrusive stack (most
+    // recent first) which any task may push to
+    Animation *animationQueue;
+
+    // The task currently batching submissions, and its deferred
+    // animations (most recent first)
+    TaskHandle_t batchTask;
+    uint32_t batchDepth;
+    Animation *batchHead;
+    Animation *batchTail;
+
+    // Completions awaiting the batch function, which are only touched
+    // by the sequencing task, or polling, which are guarded by
+    // completionLock since any task may poll
+    FfxSceneCompletionBatchFunc batchFunc;
+    bool pollCompletions;
+    FfxSceneCompletion *completions;
+    uint32_t completionCount;
+    uint32_t completionCapacity;
+
+    StaticSemaphore_t completionLockData;
+    SemaphoreHandle_t completionLock;
 
     StaticSemaphore_t renderLockData;
     SemaphoreHandle_t renderLock;
@@ -139,6 +376,22 @@ typedef struct Scene {
 void renderLock(Scene *scene);
 void renderUnlock(Scene *scene);
 
+void ffx_scene_queueAnimation(Scene *scene, Animation *animation);
+
+void* ffx_sceneNode_createKeyedAction(FfxNode node, const void *key,
+  size_t stateSize, FfxNodeActionFunc actionFunc);
+
+Render* ffx_scene_copyRenders(Scene *scene, Render *first, Render *last);
+bool ffx_scene_compareRenders(Render *first0, Render *last0, Render *first1,
+  Render *last1);
+FfxRect ffx_scene_getRenderBounds(Render *first, Render *last);
+
+FfxRect ffx_scene_unionRect(FfxRect a, FfxRect b);
+void ffx_scene_addDamage(Scene *scene, FfxRect rect);
+
+void* ffx_scene_poolAlloc(Scene *scene, size_t size);
+void ffx_scene_poolFree(Scene *scene, void *ptr);
+
 
 
 
@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "scene.h"
+
+/**
+ *  Time stopping, advancing and querying the animations of nodes in a
+ *  scene with thousands of running animations, using the per-node
+ *  animation lists against the scene-wide scan they replaced (which is
+ *  emulated here by walking every running animation for each node).
+ *
+ *  The stop and advance times include the sequence which applies them;
+ *  the scan times are only the scan, so they understate the old cost.
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define NODE_COUNT     (4000)
+#define TARGET_COUNT   (500)
+#define ROUNDS         (20)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static FfxNode nodes[NODE_COUNT];
+static int64_t sceneTime = 0;
+
+static void animate(FfxNode node, int i) {
+    ffx_sceneNode_animatePosition(node, ffx_point(i % 240, 200), 0, 60000,
+      FfxCurveLinear, NULL, NULL);
+}
+
+// The scene-wide scan, as each stop, advance or query used to do
+static __attribute__((noinline)) uint32_t scan(Scene *scene, Node *node) {
+    uint32_t count = 0;
+    Animation *animation = scene->animationHead;
+    while (animation) {
+        if (animation->node == node && !animation->stop) { count++; }
+        animation = animation->nextAnimation;
+    }
+    return count;
+}
+
+// The targets are spread through the scene
+static FfxNode target(int i) {
+    return nodes[(i * (NODE_COUNT / TARGET_COUNT)) % NODE_COUNT];
+}
+
+int main() {
+    FfxSceneConfig config = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc, .poolSlabSize = 4096
+    };
+    Scene *scene = ffx_scene_initConfig(&config);
+
+    for (int i = 0; i < NODE_COUNT; i++) {
+        nodes[i] = ffx_scene_createBox(scene, ffx_size(4, 4));
+        ffx_sceneGroup_appendChild(ffx_scene_root(scene), nodes[i]);
+        animate(nodes[i], i);
+    }
+    ffx_scene_sequenceAt(scene, sceneTime += 1000);
+
+    double stopUs = 0, advanceUs = 0, queryUs = 0;
+    double scanStopUs = 0, scanAdvanceUs = 0, scanQueryUs = 0;
+    uint32_t checks = 0;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        double t0 = now();
+        for (int i = 0; i < NODE_COUNT; i++) {
+            checks += ffx_sceneNode_isAnimating(nodes[i]);
+        }
+        queryUs += now() - t0;
+
+        t0 = now();
+        for (int i = 0; i < NODE_COUNT; i++) {
+            checks += scan(scene, nodes[i]);
+        }
+        scanQueryUs += now() - t0;
+
+        t0 = now();
+        for (int i = 0; i < TARGET_COUNT; i++) {
+            ffx_sceneNode_advanceAnimations(target(i), 1);
+        }
+        ffx_scene_sequenceAt(scene, sceneTime += 1000);
+        advanceUs += now() - t0;
+
+        t0 = now();
+        for (int i = 0; i < TARGET_COUNT; i++) {
+            checks += scan(scene, target(i));
+        }
+        scanAdvanceUs += now() - t0;
+
+        t0 = now();
+        for (int i = 0; i < TARGET_COUNT; i++) {
+            ffx_sceneNode_stopAnimations(target(i), false);
+        }
+        ffx_scene_sequenceAt(scene, sceneTime += 1000);
+        stopUs += now() - t0;
+
+        t0 = now();
+        for (int i = 0; i < TARGET_COUNT; i++) {
+            checks += scan(scene, target(i));
+        }
+        scanStopUs += now() - t0;
+
+        // Restart the stopped animations
+        for (int i = 0; i < TARGET_COUNT; i++) { animate(target(i), i); }
+        ffx_scene_sequenceAt(scene, sceneTime += 1000);
+    }
+
+    // Every node must still be animating exactly once
+    int failed = 0;
+    for (int i = 0; i < NODE_COUNT; i++) {
+        if (ffx_sceneNode_isAnimating(nodes[i]) != 1 ||
+          scan(scene, nodes[i]) != 1) {
+            printf("FAIL: node=%d animating=%d\n", i,
+              ffx_sceneNode_isAnimating(nodes[i]));
+            failed = 1;
+            break;
+        }
+    }
+
+    double scale = 1e6 / ROUNDS;
+    printf("animations=%d (checks=%d)\n", NODE_COUNT, checks);
+    printf("isAnimating x%d:  scan: %8.1fus  per-node: %8.1fus\n",
+      NODE_COUNT, scanQueryUs * scale, queryUs * scale);
+    printf("advance x%d:       scan: %8.1fus  per-node: %8.1fus "
+      "(with sequence)\n", TARGET_COUNT, scanAdvanceUs * scale,
+      advanceUs * scale);
+    printf("stop x%d:          scan: %8.1fus  per-node: %8.1fus "
+      "(with sequence)\n", TARGET_COUNT, scanStopUs * scale, stopUs * scale);
+
+    return failed;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "scene.h"
+
+/**
+ *  Time rendering a 240x240 frame of a few hundred boxes and labels
+ *  spread over the screen, visiting only the renders binned into each
+ *  fragment's band against walking the whole render list per fragment.
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define WIDTH          (240)
+#define HEIGHT         (240)
+#define FRAGMENT       (24)
+
+#define BOX_COUNT      (300)
+#define LABEL_COUNT    (100)
+#define ROUNDS         (200)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static uint16_t fragment[WIDTH * FRAGMENT];
+
+static uint64_t renderFrame(FfxScene scene) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (int y = 0; y < HEIGHT; y += FRAGMENT) {
+        ffx_scene_render(scene, fragment, ffx_point(0, y),
+          ffx_size(WIDTH, FRAGMENT));
+        for (int i = 0; i < WIDTH * FRAGMENT; i += 7) {
+            hash = (hash ^ fragment[i]) * 0x100000001b3;
+        }
+    }
+    return hash;
+}
+
+static double bench(FfxScene scene, uint64_t *hash) {
+    *hash = renderFrame(scene);
+
+    double t0 = now();
+    for (int r = 0; r < ROUNDS; r++) { renderFrame(scene); }
+    return (now() - t0) * 1e6 / ROUNDS;
+}
+
+int main() {
+    FfxSceneConfig config = { .allocFunc = allocFunc, .freeFunc = freeFunc };
+    Scene *scene = ffx_scene_initConfig(&config);
+
+    FfxNode root = ffx_scene_root(scene);
+    ffx_sceneGroup_appendChild(root,
+      ffx_scene_createFill(scene, ffx_color_rgb(0x66, 0x44, 0xaa)));
+
+    srand(42);
+    for (int i = 0; i < BOX_COUNT; i++) {
+        FfxNode box = ffx_scene_createBox(scene,
+          ffx_size(4 + rand() % 20, 4 + rand() % 20));
+        ffx_sceneBox_setColor(box, ffx_color_rgba(rand() % 256,
+          rand() % 256, rand() % 256, 8 + rand() % 25));
+        ffx_sceneNode_setPosition(box, ffx_point(rand() % WIDTH,
+          rand() % HEIGHT));
+        ffx_sceneGroup_appendChild(root, box);
+    }
+
+    for (int i = 0; i < LABEL_COUNT; i++) {
+        FfxNode label = ffx_scene_createLabel(scene, FfxFontSmall, "label");
+        ffx_sceneNode_setPosition(label, ffx_point(rand() % WIDTH,
+          rand() % HEIGHT));
+        ffx_sceneGroup_appendChild(root, label);
+    }
+
+    ffx_scene_sequenceAt(scene, 0);
+
+    RenderList *renderList = &scene->renderLists[scene->renderActive];
+
+    uint32_t total = 0, binned = 0;
+    for (Render *r = renderList->head; r; r = r->nextRender) { total++; }
+    for (int b = 0; b < renderList->bandCount; b++) {
+        binned += renderList->bands[b].count;
+    }
+
+    uint64_t bandHash, walkHash;
+    double bandUs = bench(scene, &bandHash);
+
+    // Without bands, every fragment walks the whole list
+    RenderBand *bands = renderList->bands;
+    renderList->bands = NULL;
+    double walkUs = bench(scene, &walkHash);
+    renderList->bands = bands;
+
+    printf("renders=%d  per fragment: walk=%d band=%.1f\n", total, total,
+      (double)binned / renderList->bandCount);
+    printf("frame 240x240: walk: %7.1fus  band: %7.1fus\n", walkUs, bandUs);
+
+    if (bandHash != walkHash) {
+        printf("FAIL: band render differs from the whole-list walk\n");
+        return 1;
+    }
+
+    return 0;
+}
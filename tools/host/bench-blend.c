@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "blend.h"
+
+/**
+ *  Time blending a solid color over a 240x24 fragment, one channel at a
+ *  time against the SWAR row blend, and darkening or lightening it by
+ *  25% with the generic blend against the shift-only shade. Also times
+ *  an RGB565_A4 image with its alpha scaled by the tint opacity per
+ *  pixel against mapping it through a level table.
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define WIDTH          (240)
+#define HEIGHT         (24)
+#define ROUNDS         (20000)
+
+static uint16_t fragment[WIDTH * HEIGHT];
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static __attribute__((noinline)) void blendChannels(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+
+    uint32_t inv = MAX_OPACITY - alpha;
+    uint32_t fr = ((fg >> 11) & 0x1f) * alpha;
+    uint32_t fg6 = ((fg >> 5) & 0x3f) * alpha;
+    uint32_t fb = (fg & 0x1f) * alpha;
+
+    for (int32_t i = 0; i < count; i++) {
+        uint16_t bg = output[i];
+        uint32_t r = (fr + ((bg >> 11) & 0x1f) * inv) >> 5;
+        uint32_t g = (fg6 + ((bg >> 5) & 0x3f) * inv) >> 5;
+        uint32_t b = (fb + (bg & 0x1f) * inv) >> 5;
+        output[i] = (r << 11) | (g << 5) | b;
+    }
+}
+
+static __attribute__((noinline)) void blendRow(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+    ffx_blend_row(output, count, ffx_blend_premultiply(fg, alpha), alpha);
+}
+
+static __attribute__((noinline)) void darkenBlend(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+    ffx_blend_row(output, count, ffx_blend_premultiply(0x0000, 8), 8);
+}
+
+static __attribute__((noinline)) void darkenShade(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+    ffx_blend_shadeRow(output, count, ffx_blend_getShade(8), false);
+}
+
+static __attribute__((noinline)) void lightenBlend(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+    ffx_blend_row(output, count, ffx_blend_premultiply(0xffff, 8), 8);
+}
+
+static __attribute__((noinline)) void lightenShade(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t alpha) {
+    ffx_blend_shadeRow(output, count, ffx_blend_getShade(8), true);
+}
+
+// An RGB565_A4 image the size of the fragment; 4 alpha values per word
+static uint16_t image[WIDTH * HEIGHT];
+static uint16_t imageAlpha[WIDTH * HEIGHT / 4];
+
+static inline uint32_t getImageAlpha(int32_t i) {
+    return (imageAlpha[i / 4] >> (12 - 4 * (i % 4))) & 0x0f;
+}
+
+static inline void blendImagePixel(uint16_t *output, uint16_t fg,
+  uint32_t fga) {
+    if (fga >= MAX_OPACITY) {
+        *output = fg;
+    } else if (fga) {
+        *output = ffx_blend(fg, *output, fga);
+    }
+}
+
+// Scale each 4-bit alpha and the tint opacity per pixel, as the A4
+// image render did before the level table
+static __attribute__((noinline)) void a4Multiply(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t opacity) {
+    for (int32_t i = 0; i < count; i++) {
+        uint32_t fga = (getImageAlpha(i) * opacity * 0x1111 + 0x8000) >> 16;
+        blendImagePixel(&output[i], image[i], fga);
+    }
+}
+
+// The level table is built per render (i.e. once per sequence), but is
+// built per call here
+static __attribute__((noinline)) void a4Table(uint16_t *output,
+  int32_t count, uint16_t fg, uint32_t opacity) {
+    uint8_t alphaLevels[16];
+    for (int i = 0; i < 16; i++) {
+        alphaLevels[i] = (i * opacity * 0x1111 + 0x8000) >> 16;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        blendImagePixel(&output[i], image[i], alphaLevels[getImageAlpha(i)]);
+    }
+}
+
+typedef void (*BlendFunc)(uint16_t*, int32_t, uint16_t, uint32_t);
+
+static double bench(BlendFunc blendFunc) {
+    double t0 = now();
+    for (int i = 0; i < ROUNDS; i++) {
+        blendFunc(fragment, WIDTH * HEIGHT, 0x1234 + i, 13);
+    }
+    return (now() - t0) * 1e6 / ROUNDS;
+}
+
+int main() {
+    srand(1);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) { image[i] = rand(); }
+    for (int i = 0; i < WIDTH * HEIGHT / 4; i++) { imageAlpha[i] = rand(); }
+
+    // The level table must match the per-pixel multiply exactly
+    for (uint32_t opacity = 0; opacity <= MAX_OPACITY; opacity++) {
+        static uint16_t expected[WIDTH * HEIGHT];
+        for (int i = 0; i < WIDTH * HEIGHT; i++) {
+            fragment[i] = expected[i] = rand();
+        }
+        a4Multiply(expected, WIDTH * HEIGHT, 0, opacity);
+        a4Table(fragment, WIDTH * HEIGHT, 0, opacity);
+        if (memcmp(fragment, expected, sizeof(fragment))) {
+            printf("FAIL: A4 level table differs at opacity=%d\n", opacity);
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < WIDTH * HEIGHT; i++) { fragment[i] = rand(); }
+
+    printf("blend 240x24: channels: %5.2fus  SWAR row: %5.2fus\n",
+      bench(blendChannels), bench(blendRow));
+    printf("darken 25%%:   blend:    %5.2fus  shade:    %5.2fus\n",
+      bench(darkenBlend), bench(darkenShade));
+    printf("lighten 25%%:  blend:    %5.2fus  shade:    %5.2fus\n",
+      bench(lightenBlend), bench(lightenShade));
+    printf("A4 image:     multiply: %5.2fus  levels:   %5.2fus\n",
+      bench(a4Multiply), bench(a4Table));
+
+    return 0;
+}
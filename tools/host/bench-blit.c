@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "scene.h"
+
+/**
+ *  Time rendering a 240x240 RGB565 wallpaper as ten 24-row fragments,
+ *  through ffx_scene_blit (with memcpy and with a blitFunc) against the
+ *  per-pixel copy loop it replaced.
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define WIDTH          (240)
+#define HEIGHT         (240)
+#define FRAGMENT       (24)
+#define ROUNDS         (2000)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static void blitFunc(void *dst, const void *src, size_t length,
+  void *initArg) {
+    memcpy(dst, src, length);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// The image header (format, width and height) and pixels
+static uint16_t wallpaper[3 + WIDTH * HEIGHT];
+
+static uint16_t fragment[WIDTH * FRAGMENT];
+static uint16_t expected[WIDTH * FRAGMENT];
+
+// The RGB565 image render before ffx_scene_blit, for an image at 0,0
+static __attribute__((noinline)) void copyPixels(uint16_t *frameBuffer,
+  int32_t oy) {
+
+    const uint16_t *data = &wallpaper[3];
+    for (int32_t y = FRAGMENT; y; y--) {
+        uint16_t *output = &frameBuffer[WIDTH * (y - 1)];
+        const uint16_t *input = &data[(oy + y - 1) * WIDTH];
+        for (int32_t x = WIDTH; x; x--) {
+            *output++ = *input++;
+        }
+    }
+}
+
+// Returns the us per frame
+static double benchScene(FfxSceneBlitFunc func) {
+    FfxSceneConfig config = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc, .blitFunc = func
+    };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene),
+      ffx_scene_createImage(scene, wallpaper, sizeof(wallpaper)));
+    ffx_scene_sequenceAt(scene, 0);
+
+    for (int32_t y = 0; y < HEIGHT; y += FRAGMENT) {
+        ffx_scene_render(scene, fragment, ffx_point(0, y),
+          ffx_size(WIDTH, FRAGMENT));
+        copyPixels(expected, y);
+        if (memcmp(fragment, expected, sizeof(fragment))) {
+            printf("FAIL: fragment at y=%d differs\n", y);
+            exit(1);
+        }
+    }
+
+    double t0 = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int32_t y = 0; y < HEIGHT; y += FRAGMENT) {
+            ffx_scene_render(scene, fragment, ffx_point(0, y),
+              ffx_size(WIDTH, FRAGMENT));
+        }
+    }
+    return (now() - t0) * 1e6 / ROUNDS;
+}
+
+static double benchPixels() {
+    double t0 = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int32_t y = 0; y < HEIGHT; y += FRAGMENT) {
+            copyPixels(fragment, y);
+        }
+    }
+    return (now() - t0) * 1e6 / ROUNDS;
+}
+
+int main() {
+    wallpaper[0] = 0x04;
+    wallpaper[1] = WIDTH;
+    wallpaper[2] = HEIGHT;
+
+    srand(1);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) { wallpaper[3 + i] = rand(); }
+
+    double pixelsUs = benchPixels();
+    double memcpyUs = benchScene(NULL);
+    double blitUs = benchScene(blitFunc);
+
+    printf("wallpaper 240x240: per-pixel: %5.1fus  blit (memcpy): %5.1fus  "
+      "blit (blitFunc): %5.1fus  (per frame)\n", pixelsUs, memcpyUs, blitUs);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "firefly-curves.h"
+
+/**
+ *  Time evaluating each built-in curve directly against its sampled
+ *  table, in ns per evaluation, along with the maximum error of the
+ *  table over every fixed-point input (where 65 is 1/1000).
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define ROUNDS         (20)
+
+#define CURVE(name)    { #name, name }
+
+static const struct {
+    const char *name;
+    FfxCurveFunc curve;
+} curves[] = {
+    CURVE(FfxCurveLinear),
+    CURVE(FfxCurveEaseInSine),
+    CURVE(FfxCurveEaseOutSine),
+    CURVE(FfxCurveEaseInOutSine),
+    CURVE(FfxCurveEaseInQuad),
+    CURVE(FfxCurveEaseInOutCubic),
+    CURVE(FfxCurveEaseInOutQuint),
+    CURVE(FfxCurveEaseInExpo),
+    CURVE(FfxCurveEaseOutExpo),
+    CURVE(FfxCurveEaseOutBack),
+    CURVE(FfxCurveEaseInElastic),
+    CURVE(FfxCurveEaseOutElastic),
+};
+#define CURVE_COUNT    (sizeof(curves) / sizeof(curves[0]))
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static volatile fixed_ffxt sink;
+
+int main() {
+    printf("%-24s %8s %8s %6s\n", "curve", "func", "table", "error");
+
+    for (int i = 0; i < CURVE_COUNT; i++) {
+        FfxCurveFunc curve = curves[i].curve;
+
+        FfxCurveTable table;
+        ffx_curve_initTable(&table, curve);
+
+        int32_t maxError = 0;
+        for (int32_t t = 0; t <= 0x10000; t++) {
+            int32_t error = ffx_curve_evalTable(&table, t) - curve(t);
+            if (error < 0) { error = -error; }
+            if (error > maxError) { maxError = error; }
+        }
+
+        fixed_ffxt sum = 0;
+        double t0 = now();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int32_t t = 0; t <= 0x10000; t++) { sum += curve(t); }
+        }
+        double funcNs = (now() - t0) * 1e9 / (ROUNDS * 0x10001);
+
+        t0 = now();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int32_t t = 0; t <= 0x10000; t++) {
+                sum += ffx_curve_evalTable(&table, t);
+            }
+        }
+        double tableNs = (now() - t0) * 1e9 / (ROUNDS * 0x10001);
+        sink = sum;
+
+        printf("%-24s %6.1fns %6.1fns %6d\n", curves[i].name, funcNs,
+          tableNs, maxError);
+    }
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "blend.h"
+#include "scene.h"
+
+/**
+ *  Measure the fill node throughput, in pixels/sec, for opaque, shaded
+ *  (i.e. RGBA_DARKER50) and translucent fills, for the specialized (240
+ *  and 320) and generic strides, and for a viewport narrower than the
+ *  stride.
+ *
+ *  Also times opaque rects from 1 pixel to (nearly) the full width with
+ *  the row filler against variants without its narrow cutoff and 64-bit
+ *  path, and against a plain per-pixel loop.
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define FRAGMENT       (24)
+#define MAX_STRIDE     (320)
+#define PIXELS         (40000000)
+#define RUNS           (5)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static uint16_t fragment[MAX_STRIDE * FRAGMENT];
+
+typedef struct Case {
+    const char *name;
+    uint16_t stride;
+    FfxSize viewport;
+} Case;
+
+static const Case cases[] = {
+    { "stride=240 240x24", 240, { 240, FRAGMENT } },
+    { "stride=320 320x24", 320, { 320, FRAGMENT } },
+    { "stride=256 256x24", 256, { 256, FRAGMENT } },
+    { "stride=240 120x24", 240, { 120, FRAGMENT } },
+};
+#define CASE_COUNT     (sizeof(cases) / sizeof(cases[0]))
+
+// Returns the throughput, in megapixels/sec
+static double bench(const Case *c, color_ffxt color) {
+    FfxSceneConfig config = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc,
+        .width = c->stride, .stride = c->stride
+    };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene),
+      ffx_scene_createFill(scene, color));
+    ffx_scene_sequenceAt(scene, 0);
+
+    int32_t pixels = c->viewport.width * c->viewport.height;
+    int32_t rounds = PIXELS / pixels;
+
+    // The best of several runs, as the host is noisy
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        double t0 = now();
+        for (int32_t r = 0; r < rounds; r++) {
+            ffx_scene_render(scene, fragment, ffx_point(0, 0), c->viewport);
+        }
+
+        double rate = (double)rounds * pixels / (now() - t0) / 1e6;
+        if (rate > best) { best = rate; }
+    }
+
+    return best;
+}
+
+// Rect fills of 24 rows at a stride of 240, one ffx_blend_fill per row,
+// against the same row filler without the narrow cutoff, without the
+// 64-bit path and a plain per-pixel loop
+
+typedef void (*FillFunc)(uint16_t*, int32_t, uint32_t);
+
+static __attribute__((noinline)) void fillRow(uint16_t *output,
+  int32_t count, uint32_t pixels) {
+    ffx_blend_fill(output, count, pixels);
+}
+
+static __attribute__((noinline)) void fillLoop(uint16_t *output,
+  int32_t count, uint32_t pixels) {
+    while (count-- > 0) { *output++ = pixels; }
+}
+
+static __attribute__((noinline)) void fillNoCutoff(uint16_t *output,
+  int32_t count, uint32_t pixels) {
+    if (count <= 0) { return; }
+    if ((uintptr_t)output & 2) {
+        *output++ = pixels;
+        count--;
+    }
+
+    uint32_t *words = (uint32_t*)output;
+    if (count >= 8) {
+        if ((uintptr_t)words & 4) {
+            *words++ = pixels;
+            count -= 2;
+        }
+        uint64_t quad = ((uint64_t)pixels << 32) | pixels;
+        uint64_t *dwords = (uint64_t*)words;
+        for (int32_t i = count >> 2; i; i--) { *dwords++ = quad; }
+        words = (uint32_t*)dwords;
+        count &= 3;
+    }
+
+    for (int32_t i = count >> 1; i; i--) { *words++ = pixels; }
+    if (count & 1) { *(uint16_t*)words = pixels; }
+}
+
+static __attribute__((noinline)) void fill32(uint16_t *output,
+  int32_t count, uint32_t pixels) {
+    if (count < 3) {
+        while (count-- > 0) { *output++ = pixels; }
+        return;
+    }
+    if ((uintptr_t)output & 2) {
+        *output++ = pixels;
+        count--;
+    }
+
+    uint32_t *words = (uint32_t*)output;
+    for (int32_t i = count >> 1; i; i--) { *words++ = pixels; }
+    if (count & 1) { *(uint16_t*)words = pixels; }
+}
+
+// Returns ns per rect; the rects start at odd and even columns
+static double benchRect(FillFunc fillFunc, int32_t width) {
+    int32_t rounds = PIXELS / 4 / (width * FRAGMENT + 64);
+    uint32_t pixels = ffx_blend_pair(0x6455);
+
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        double t0 = now();
+        for (int32_t r = 0; r < rounds; r++) {
+            uint16_t *output = &fragment[r & 1];
+            for (int32_t y = 0; y < FRAGMENT; y++) {
+                fillFunc(output, width, pixels);
+                output += 240;
+            }
+        }
+        double ns = (now() - t0) * 1e9 / rounds;
+        if (run == 0 || ns < best) { best = ns; }
+    }
+
+    return best;
+}
+
+int main() {
+    printf("%-18s %9s %9s %9s  (Mpx/s)\n", "fill", "opaque", "darken50",
+      "blend");
+
+    for (int i = 0; i < CASE_COUNT; i++) {
+        double opaque = bench(&cases[i], ffx_color_rgb(0x66, 0x44, 0xaa));
+        double darken = bench(&cases[i], RGBA_DARKER50);
+        double blend = bench(&cases[i], ffx_color_rgba(0x66, 0x44, 0xaa, 12));
+        printf("%-18s %9.0f %9.0f %9.0f\n", cases[i].name, opaque, darken,
+          blend);
+    }
+
+    const int32_t widths[] = { 1, 2, 3, 4, 8, 16, 40, 120, 239 };
+
+    printf("\n%-10s %9s %9s %9s %9s  (ns per %d-row rect)\n", "width",
+      "fill", "no-cutoff", "32-bit", "loop", FRAGMENT);
+
+    for (int i = 0; i < sizeof(widths) / sizeof(widths[0]); i++) {
+        printf("%-10d %9.1f %9.1f %9.1f %9.1f\n", widths[i],
+          benchRect(fillRow, widths[i]), benchRect(fillNoCutoff, widths[i]),
+          benchRect(fill32, widths[i]), benchRect(fillLoop, widths[i]));
+    }
+
+    return 0;
+}
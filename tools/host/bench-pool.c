@@ -0,0 +1,171 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "scene.h"
+
+/**
+ *  Compare the pooled allocator against the plain allocFunc path for
+ *  the node, action and animation sizes: on the pool task alone, with
+ *  another task freeing what the pool task allocated (as a render or
+ *  producer task may) and with other tasks allocating concurrently
+ *  (which fallback onto allocFunc).
+ *
+ *  To run:
+ *    make bench
+ */
+
+#define BATCH          (64)
+#define ROUNDS         (20000)
+#define TASK_COUNT     (4)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// The mix of sizes allocated while animating
+static const size_t sizes[] = {
+    sizeof(Node) + 16, sizeof(Animation), sizeof(Action) + 24,
+    sizeof(Action) + 24, sizeof(Action) + 8
+};
+#define SIZE_COUNT     (sizeof(sizes) / sizeof(sizes[0]))
+
+static void churn(Scene *scene, int rounds) {
+    void *ptrs[BATCH];
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < BATCH; i++) {
+            ptrs[i] = ffx_scene_poolAlloc(scene, sizes[i % SIZE_COUNT]);
+            if (ptrs[i] == NULL) { abort(); }
+        }
+        for (int i = 0; i < BATCH; i++) {
+            ffx_scene_poolFree(scene, ptrs[i]);
+        }
+    }
+}
+
+static void* runTask(void *scene) {
+    churn(scene, ROUNDS / TASK_COUNT);
+    return NULL;
+}
+
+static double benchLocal(Scene *scene) {
+    double t0 = now();
+    churn(scene, ROUNDS);
+    return (now() - t0) * 1e9 / (ROUNDS * BATCH);
+}
+
+// A batch handed from the pool task to the freeing task, which clears
+// the mailbox once every entry is freed
+static void *batch[BATCH];
+static void **mailbox;
+
+static void* runFreeTask(void *scene) {
+    for (int r = 0; r < ROUNDS; r++) {
+        while (!__atomic_load_n(&mailbox, __ATOMIC_ACQUIRE)) { sched_yield(); }
+        for (int i = 0; i < BATCH; i++) { ffx_scene_poolFree(scene, batch[i]); }
+        __atomic_store_n(&mailbox, NULL, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+static double benchRemote(Scene *scene) {
+    pthread_t task;
+    pthread_create(&task, NULL, runFreeTask, scene);
+
+    double t0 = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        while (__atomic_load_n(&mailbox, __ATOMIC_ACQUIRE)) { sched_yield(); }
+        for (int i = 0; i < BATCH; i++) {
+            batch[i] = ffx_scene_poolAlloc(scene, sizes[i % SIZE_COUNT]);
+            if (batch[i] == NULL) { abort(); }
+        }
+        __atomic_store_n(&mailbox, batch, __ATOMIC_RELEASE);
+    }
+    pthread_join(task, NULL);
+
+    return (now() - t0) * 1e9 / (ROUNDS * BATCH);
+}
+
+static double benchShared(Scene *scene) {
+    pthread_t tasks[TASK_COUNT];
+
+    double t0 = now();
+    for (int i = 1; i < TASK_COUNT; i++) {
+        pthread_create(&tasks[i], NULL, runTask, scene);
+    }
+    runTask(scene);
+    for (int i = 1; i < TASK_COUNT; i++) {
+        pthread_join(tasks[i], NULL);
+    }
+
+    return (now() - t0) * 1e9 / (ROUNDS * BATCH);
+}
+
+static void report(const char *name, double (*bench)(Scene*),
+  Scene *plainScene, Scene *pooledScene) {
+    double plainNs = bench(plainScene);
+    double pooledNs = bench(pooledScene);
+    printf("%-14s allocFunc: %5.1fns  pool: %5.1fns  (per alloc+free)\n",
+      name, plainNs, pooledNs);
+}
+
+static uint32_t countSlots(PoolSlot *slot) {
+    uint32_t count = 0;
+    for (; slot; slot = slot->nextFree) { count++; }
+    return count;
+}
+
+int main() {
+    FfxSceneConfig plain = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc
+    };
+    FfxSceneConfig pooled = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc, .poolSlabSize = 2048
+    };
+
+    Scene *plainScene = ffx_scene_initConfig(&plain);
+    Scene *pooledScene = ffx_scene_initConfig(&pooled);
+
+    // Warm up, so the pool has grown to fit
+    churn(pooledScene, 1);
+
+    // The root node remains allocated
+    uint32_t used[POOL_CLASS_COUNT];
+    for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+        used[i] = pooledScene->pool.classes[i].used;
+    }
+
+    report("pool task:", benchLocal, plainScene, pooledScene);
+    report("remote free:", benchRemote, plainScene, pooledScene);
+    report("shared:", benchShared, plainScene, pooledScene);
+
+    // Every entry must have been returned to its class
+    int failed = 0;
+    for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+        PoolClass *poolClass = &pooledScene->pool.classes[i];
+
+        uint32_t count = countSlots(poolClass->freeHead) +
+          countSlots(poolClass->returnHead);
+
+        if (poolClass->used != used[i] ||
+          count + used[i] != poolClass->capacity) {
+            printf("FAIL: class=%d used=%d free=%d capacity=%d\n", i,
+              poolClass->used, count, poolClass->capacity);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
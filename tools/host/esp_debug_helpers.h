@@ -0,0 +1,6 @@
+#ifndef __FIREFLY_HOST_ESP_DEBUG_HELPERS_H__
+#define __FIREFLY_HOST_ESP_DEBUG_HELPERS_H__
+
+static inline void esp_backtrace_print(int depth) { }
+
+#endif /* __FIREFLY_HOST_ESP_DEBUG_HELPERS_H__ */
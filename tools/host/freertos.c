@@ -0,0 +1,38 @@
+#include <pthread.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+
+TickType_t xTaskGetTickCount(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (TaskHandle_t)pthread_self();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    struct timespec delay = {
+        .tv_sec = ticks / 1000,
+        .tv_nsec = (ticks % 1000) * 1000000
+    };
+    nanosleep(&delay, NULL);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer) {
+    pthread_mutex_init(&buffer->mutex, NULL);
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    return pthread_mutex_lock(&semaphore->mutex) == 0;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return pthread_mutex_unlock(&semaphore->mutex) == 0;
+}
@@ -0,0 +1,21 @@
+#ifndef __FIREFLY_HOST_FREERTOS_H__
+#define __FIREFLY_HOST_FREERTOS_H__
+
+// Just enough of FreeRTOS (backed by pthreads) to build the scene on a
+// host; see freertos.c
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE               (1)
+#define pdFALSE              (0)
+
+#define portMAX_DELAY        (0xffffffff)
+#define portTICK_PERIOD_MS   (1)
+
+typedef void* TaskHandle_t;
+
+#endif /* __FIREFLY_HOST_FREERTOS_H__ */
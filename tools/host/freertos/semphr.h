@@ -0,0 +1,18 @@
+#ifndef __FIREFLY_HOST_SEMPHR_H__
+#define __FIREFLY_HOST_SEMPHR_H__
+
+#include <pthread.h>
+
+#include "FreeRTOS.h"
+
+typedef struct StaticSemaphore_t {
+    pthread_mutex_t mutex;
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+
+#endif /* __FIREFLY_HOST_SEMPHR_H__ */
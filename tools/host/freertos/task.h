@@ -0,0 +1,10 @@
+#ifndef __FIREFLY_HOST_TASK_H__
+#define __FIREFLY_HOST_TASK_H__
+
+#include "FreeRTOS.h"
+
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskDelay(TickType_t ticks);
+
+#endif /* __FIREFLY_HOST_TASK_H__ */
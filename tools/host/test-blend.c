@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "blend.h"
+
+/**
+ *  The SWAR blend must match blending each channel separately with
+ *  (fg * alpha + bg * (MAX_OPACITY - alpha)) >> 5, for every background
+ *  and alpha, whether blended alone or two per word at any alignment.
+ *
+ *  The shift-only shades must match blending black or white with the
+ *  generic blend exactly or, where they round up, be at most one LSB
+ *  brighter in each channel, for every pixel.
+ *
+ *  To run:
+ *    make test
+ */
+
+#define FG_COUNT       (64)
+
+static int failed = 0;
+
+// The reference blend, one channel at a time
+static uint16_t blendChannels(uint16_t fg, uint16_t bg, uint32_t alpha) {
+    uint32_t inv = MAX_OPACITY - alpha;
+    uint32_t r = (((fg >> 11) & 0x1f) * alpha + ((bg >> 11) & 0x1f) * inv) >> 5;
+    uint32_t g = (((fg >> 5) & 0x3f) * alpha + ((bg >> 5) & 0x3f) * inv) >> 5;
+    uint32_t b = ((fg & 0x1f) * alpha + (bg & 0x1f) * inv) >> 5;
+    return (r << 11) | (g << 5) | b;
+}
+
+static void testPixels() {
+    uint16_t fgs[FG_COUNT] = { 0x0000, 0xffff, 0xf800, 0x07e0, 0x001f };
+    srand(1);
+    for (int i = 5; i < FG_COUNT; i++) { fgs[i] = rand(); }
+
+    for (uint32_t alpha = 0; alpha <= MAX_OPACITY; alpha++) {
+        for (int i = 0; i < FG_COUNT; i++) {
+            uint16_t fg = fgs[i];
+            for (uint32_t bg = 0; bg <= 0xffff; bg++) {
+                uint16_t expected = blendChannels(fg, bg, alpha);
+                uint16_t result = ffx_blend(fg, bg, alpha);
+                if (result != expected) {
+                    printf("FAIL: blend fg=%04x bg=%04x alpha=%d: %04x "
+                      "(expected %04x)\n", fg, bg, alpha, result, expected);
+                    failed = 1;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static void testRows() {
+    uint16_t input[64], output[64 + 2];
+
+    srand(2);
+    for (int i = 0; i < 64; i++) { input[i] = rand(); }
+
+    for (uint32_t alpha = 0; alpha <= MAX_OPACITY; alpha++) {
+        uint16_t fg = rand();
+        uint32_t fgpm = ffx_blend_premultiply(fg, alpha);
+
+        for (int offset = 0; offset < 2; offset++) {
+            for (int count = 0; count <= 64; count++) {
+                memset(output, 0xa5, sizeof(output));
+                memcpy(&output[offset], input, count * sizeof(uint16_t));
+
+                ffx_blend_row(&output[offset], count, fgpm, alpha);
+
+                for (int i = 0; i < 64 + 2; i++) {
+                    uint16_t expected = 0xa5a5;
+                    if (i >= offset && i < offset + count) {
+                        expected = blendChannels(fg, input[i - offset],
+                          alpha);
+                    }
+                    if (output[i] != expected) {
+                        printf("FAIL: row alpha=%d offset=%d count=%d i=%d: "
+                          "%04x (expected %04x)\n", alpha, offset, count, i,
+                          output[i], expected);
+                        failed = 1;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The opacity of each shade, and whether its darken rounds up (all
+// lightens do)
+static const uint32_t shadeOpacity[SHADE_COUNT] = { 4, 8, 16, 24, 28 };
+static const bool shadeRoundsUp[SHADE_COUNT] = { true, true, false, false,
+  false };
+
+// Each channel of %%result%% must be the same as %%expected%%, or if
+// %%roundsUp%% one greater
+static bool matchShade(uint16_t result, uint16_t expected, bool roundsUp) {
+    const uint16_t masks[] = { 0xf800, 0x07e0, 0x001f };
+    const uint16_t lsbs[] = { 0x0800, 0x0020, 0x0001 };
+
+    for (int i = 0; i < 3; i++) {
+        uint16_t r = result & masks[i], e = expected & masks[i];
+        if (r == e) { continue; }
+        if (!roundsUp || r != e + lsbs[i]) { return false; }
+    }
+
+    return true;
+}
+
+static void testShades() {
+    for (int32_t shade = 0; shade < SHADE_COUNT; shade++) {
+        uint32_t opacity = shadeOpacity[shade];
+
+        if (ffx_blend_getShade(opacity) != shade) {
+            printf("FAIL: getShade opacity=%d\n", opacity);
+            failed = 1;
+        }
+
+        for (uint32_t bg = 0; bg <= 0xffff; bg++) {
+            uint16_t dark = ffx_blend_darken(bg, shade);
+            uint16_t light = ffx_blend_lighten(bg, shade);
+
+            if (!matchShade(dark, blendChannels(0x0000, bg, opacity),
+              shadeRoundsUp[shade])) {
+                printf("FAIL: darken shade=%d bg=%04x: %04x (expected "
+                  "%04x)\n", shade, bg, dark,
+                  blendChannels(0x0000, bg, opacity));
+                failed = 1;
+                return;
+            }
+
+            if (!matchShade(light, blendChannels(0xffff, bg, opacity), true)) {
+                printf("FAIL: lighten shade=%d bg=%04x: %04x (expected "
+                  "%04x)\n", shade, bg, light,
+                  blendChannels(0xffff, bg, opacity));
+                failed = 1;
+                return;
+            }
+
+            // Two per word, with a different neighbour
+            uint32_t pair = bg | ((uint32_t)(bg ^ 0x5a5a) << 16);
+            uint32_t darkPair = ffx_blend_darken(pair, shade);
+            uint32_t lightPair = ffx_blend_lighten(pair, shade);
+            if ((uint16_t)darkPair != dark || (uint16_t)lightPair != light ||
+              (uint16_t)(darkPair >> 16) !=
+              (uint16_t)ffx_blend_darken(bg ^ 0x5a5a, shade) ||
+              (uint16_t)(lightPair >> 16) !=
+              (uint16_t)ffx_blend_lighten(bg ^ 0x5a5a, shade)) {
+                printf("FAIL: pair shade=%d bg=%04x\n", shade, bg);
+                failed = 1;
+                return;
+            }
+        }
+    }
+
+    // The remaining opacities use the generic blend
+    for (uint32_t opacity = 0; opacity <= MAX_OPACITY; opacity++) {
+        bool shaded = false;
+        for (int i = 0; i < SHADE_COUNT; i++) {
+            if (shadeOpacity[i] == opacity) { shaded = true; }
+        }
+        if (!shaded && ffx_blend_getShade(opacity) != -1) {
+            printf("FAIL: getShade opacity=%d\n", opacity);
+            failed = 1;
+        }
+    }
+}
+
+static void testShadeRows() {
+    uint16_t input[64], output[64 + 2];
+
+    srand(3);
+    for (int i = 0; i < 64; i++) { input[i] = rand(); }
+
+    for (int32_t shade = 0; shade < SHADE_COUNT; shade++) {
+        for (int lighten = 0; lighten < 2; lighten++) {
+            for (int offset = 0; offset < 2; offset++) {
+                for (int count = 0; count <= 64; count++) {
+                    memset(output, 0xa5, sizeof(output));
+                    memcpy(&output[offset], input, count * sizeof(uint16_t));
+
+                    ffx_blend_shadeRow(&output[offset], count, shade, lighten);
+
+                    for (int i = 0; i < 64 + 2; i++) {
+                        uint16_t expected = 0xa5a5;
+                        if (i >= offset && i < offset + count) {
+                            uint16_t bg = input[i - offset];
+                            expected = lighten ? ffx_blend_lighten(bg, shade):
+                              ffx_blend_darken(bg, shade);
+                        }
+                        if (output[i] != expected) {
+                            printf("FAIL: shade row shade=%d lighten=%d "
+                              "offset=%d count=%d i=%d\n", shade, lighten,
+                              offset, count, i);
+                            failed = 1;
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    testPixels();
+    testRows();
+    testShades();
+    testShadeRows();
+
+    return failed;
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "firefly-curves.h"
+
+/**
+ *  Each built-in curve sampled into a table must stay within 1/1000 of
+ *  the curve at every fixed-point input.
+ *
+ *  EaseInOutExpo and the Bounce curves are not continuous as currently
+ *  implemented (see curves.c), so a table cannot follow them and they
+ *  are excluded.
+ *
+ *  To run:
+ *    make test
+ */
+
+#define MAX_ERROR      (0x10000 / 1000)
+
+#define CURVE(name)    { #name, name }
+
+static const struct {
+    const char *name;
+    FfxCurveFunc curve;
+} curves[] = {
+    CURVE(FfxCurveLinear),
+    CURVE(FfxCurveEaseInSine),
+    CURVE(FfxCurveEaseOutSine),
+    CURVE(FfxCurveEaseInOutSine),
+    CURVE(FfxCurveEaseInQuad),
+    CURVE(FfxCurveEaseOutQuad),
+    CURVE(FfxCurveEaseInOutQuad),
+    CURVE(FfxCurveEaseInCubic),
+    CURVE(FfxCurveEaseOutCubic),
+    CURVE(FfxCurveEaseInOutCubic),
+    CURVE(FfxCurveEaseInQuart),
+    CURVE(FfxCurveEaseOutQuart),
+    CURVE(FfxCurveEaseInOutQuart),
+    CURVE(FfxCurveEaseInQuint),
+    CURVE(FfxCurveEaseOutQuint),
+    CURVE(FfxCurveEaseInOutQuint),
+    CURVE(FfxCurveEaseInExpo),
+    CURVE(FfxCurveEaseOutExpo),
+    CURVE(FfxCurveEaseInBack),
+    CURVE(FfxCurveEaseOutBack),
+    CURVE(FfxCurveEaseInElastic),
+    CURVE(FfxCurveEaseOutElastic),
+};
+#define CURVE_COUNT    (sizeof(curves) / sizeof(curves[0]))
+
+int main() {
+    int failed = 0;
+
+    for (int i = 0; i < CURVE_COUNT; i++) {
+        FfxCurveTable table;
+        ffx_curve_initTable(&table, curves[i].curve);
+
+        int32_t maxError = 0, maxT = 0;
+        for (int32_t t = 0; t <= 0x10000; t++) {
+            int32_t error = ffx_curve_evalTable(&table, t) -
+              curves[i].curve(t);
+            if (error < 0) { error = -error; }
+            if (error > maxError) {
+                maxError = error;
+                maxT = t;
+            }
+        }
+
+        if (maxError > MAX_ERROR) {
+            printf("FAIL: %s: error=%d at t=0x%x (max %d)\n", curves[i].name,
+              maxError, maxT, MAX_ERROR);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
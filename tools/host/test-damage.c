@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scene.h"
+
+/**
+ *  A sequence must report a change while the most recently published
+ *  render list, which the render pass never acquired, holds damage that
+ *  was never presented.
+ *
+ *  A dirty group whose children are all re-used must not damage the
+ *  bounds of its children, even once a child is removed.
+ *
+ *  To run:
+ *    make test
+ */
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static int failed = 0;
+
+static void check(const char *step, bool changed, bool expected) {
+    if (changed != expected) {
+        printf("FAIL: %s: changed=%d (expected %d)\n", step, changed,
+          expected);
+        failed = 1;
+    }
+}
+
+static void checkDamage(const char *step, FfxScene scene, FfxRect expected) {
+    FfxRect damage = ffx_scene_getDamage(scene);
+    if (damage.origin.x != expected.origin.x ||
+      damage.origin.y != expected.origin.y ||
+      damage.size.width != expected.size.width ||
+      damage.size.height != expected.size.height) {
+        printf("FAIL: %s: damage=%dx%d@%d,%d (expected %dx%d@%d,%d)\n",
+          step, damage.size.width, damage.size.height, damage.origin.x,
+          damage.origin.y, expected.size.width, expected.size.height,
+          expected.origin.x, expected.origin.y);
+        failed = 1;
+    }
+}
+
+int main() {
+    FfxSceneConfig config = { .allocFunc = allocFunc, .freeFunc = freeFunc };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    FfxNode box = ffx_scene_createBox(scene, ffx_size(10, 10));
+    ffx_sceneBox_setColor(box, ffx_color_rgb(255, 0, 0));
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), box);
+
+    check("initial", ffx_scene_sequenceAt(scene, 0), true);
+    ffx_scene_acquireRender(scene);
+
+    // Moved, but the render pass does not acquire the list
+    ffx_sceneNode_setPosition(box, ffx_point(20, 20));
+    check("moved", ffx_scene_sequenceAt(scene, 1000), true);
+
+    // Dirty, but with identical renders; the move is still pending
+    ffx_sceneNode_setPosition(box, ffx_point(20, 20));
+    check("unchanged", ffx_scene_sequenceAt(scene, 2000), true);
+
+    ffx_scene_acquireRender(scene);
+
+    // Presented; nothing is pending
+    ffx_sceneNode_setPosition(box, ffx_point(20, 20));
+    check("presented", ffx_scene_sequenceAt(scene, 3000), false);
+
+    // A group spanning the screen; dirty, but its children are re-used
+    FfxNode group = ffx_scene_createGroup(scene);
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), group);
+    for (int i = 0; i < 8; i++) {
+        box = ffx_scene_createBox(scene, ffx_size(10, 10));
+        ffx_sceneBox_setColor(box, ffx_color_rgb(0, 255, 0));
+        ffx_sceneNode_setPosition(box, ffx_point(i * 30, i * 30));
+        ffx_sceneGroup_appendChild(group, box);
+    }
+
+    check("group added", ffx_scene_sequenceAt(scene, 4000), true);
+    ffx_scene_acquireRender(scene);
+
+    ffx_sceneNode_setPosition(group, ffx_point(0, 0));
+    check("group unchanged", ffx_scene_sequenceAt(scene, 5000), false);
+    ffx_scene_acquireRender(scene);
+
+    checkDamage("group unchanged", scene, (FfxRect){ 0 });
+
+    // Removing a child only damages that child; the rest are re-used
+    ffx_sceneNode_remove(box);
+    check("child removed", ffx_scene_sequenceAt(scene, 6000), true);
+    ffx_scene_acquireRender(scene);
+
+    checkDamage("child removed", scene, (FfxRect){
+        .origin = ffx_point(210, 210), .size = ffx_size(10, 10)
+    });
+
+    return failed;
+}
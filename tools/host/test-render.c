@@ -0,0 +1,144 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scene.h"
+
+/**
+ *  A render task acquiring and rendering snapshots while the scene is
+ *  mutated and sequenced on another task must only ever see complete
+ *  snapshots; every frame must match one of the states rendered alone.
+ *
+ *  Run this under -fsanitize=thread to catch races the frame checks do
+ *  not (see the Makefile).
+ *
+ *  To run:
+ *    make test
+ */
+
+#define WIDTH          (240)
+#define HEIGHT         (240)
+#define FRAGMENT       (24)
+
+#define STATES         (4)
+#define SEQUENCES      (2000)
+#define BOX_COUNT      (16)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static FfxNode boxes[BOX_COUNT];
+static FfxNode label;
+static FfxNode extra;
+
+// Each state moves the boxes, changes the label and adds or removes
+// (and frees) an extra node
+static void setState(FfxScene scene, int state) {
+    for (int i = 0; i < BOX_COUNT; i++) {
+        ffx_sceneNode_setPosition(boxes[i], ffx_point(i * 14,
+          (i * 31 + state * 47) % 200));
+    }
+
+    ffx_sceneLabel_setTextFormat(label, "state %d", state);
+
+    if (state & 1) {
+        extra = ffx_scene_createBox(scene, ffx_size(60, 30));
+        ffx_sceneBox_setColor(extra, ffx_color_rgba(0, 0, 255, 20));
+        ffx_sceneNode_setPosition(extra, ffx_point(state * 30, 100));
+        ffx_sceneGroup_appendChild(ffx_scene_root(scene), extra);
+    } else if (extra) {
+        ffx_sceneNode_remove(extra);
+        extra = NULL;
+    }
+}
+
+static uint64_t renderFrame(FfxScene scene) {
+    static uint16_t fragment[WIDTH * FRAGMENT];
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for (int y = 0; y < HEIGHT; y += FRAGMENT) {
+        ffx_scene_render(scene, fragment, ffx_point(0, y),
+          ffx_size(WIDTH, FRAGMENT));
+        for (int i = 0; i < WIDTH * FRAGMENT; i++) {
+            hash = (hash ^ fragment[i]) * 0x100000001b3;
+        }
+    }
+
+    return hash;
+}
+
+static uint64_t hashes[STATES];
+static bool done = false;
+static int frames = 0, mismatches = 0;
+
+static void* runRender(void *scene) {
+    while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+        ffx_scene_acquireRender(scene);
+        ffx_scene_getDamage(scene);
+
+        uint64_t hash = renderFrame(scene);
+
+        bool found = false;
+        for (int i = 0; i < STATES; i++) {
+            if (hash == hashes[i]) { found = true; }
+        }
+        if (!found) { mismatches++; }
+        frames++;
+    }
+
+    return NULL;
+}
+
+int main() {
+    FfxSceneConfig config = {
+        .allocFunc = allocFunc, .freeFunc = freeFunc, .poolSlabSize = 2048
+    };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    FfxNode root = ffx_scene_root(scene);
+    ffx_sceneGroup_appendChild(root,
+      ffx_scene_createFill(scene, ffx_color_rgb(0x66, 0x44, 0xaa)));
+
+    for (int i = 0; i < BOX_COUNT; i++) {
+        boxes[i] = ffx_scene_createBox(scene, ffx_size(20, 20));
+        ffx_sceneBox_setColor(boxes[i], ffx_color_rgba(255, i * 15, 0,
+          8 + i));
+        ffx_sceneGroup_appendChild(root, boxes[i]);
+    }
+
+    label = ffx_scene_createLabel(scene, FfxFontLarge, "");
+    ffx_sceneNode_setPosition(label, ffx_point(20, 210));
+    ffx_sceneGroup_appendChild(root, label);
+
+    // Each state rendered alone, before the render pass acquires
+    int64_t now = 0;
+    for (int i = 0; i < STATES; i++) {
+        setState(scene, i);
+        ffx_scene_sequenceAt(scene, now += 1000);
+        hashes[i] = renderFrame(scene);
+    }
+
+    pthread_t task;
+    pthread_create(&task, NULL, runRender, scene);
+
+    for (int i = 0; i < SEQUENCES; i++) {
+        setState(scene, i % STATES);
+        ffx_scene_sequenceAt(scene, now += 1000);
+        if ((i % 8) == 0) { vTaskDelay(1); }
+    }
+
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+    pthread_join(task, NULL);
+
+    if (mismatches || frames == 0) {
+        printf("FAIL: frames=%d mismatches=%d\n", frames, mismatches);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scene.h"
+
+/**
+ *  Renders re-used by a clean subtree must remain re-usable by each of
+ *  its descendants, so only changed nodes are sequenced.
+ *
+ *  To run:
+ *    make test
+ */
+
+#define BOX_COUNT      (50)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static int failed = 0;
+
+static void check(Scene *scene, const char *step, uint32_t reuseCount,
+  uint32_t seqNodes) {
+
+    uint32_t seq = scene->sequenceNodes;
+    uint32_t reuse = scene->stats.reuseCount;
+    scene->sequenceNodes = 0;
+    scene->stats.reuseCount = 0;
+
+    if (reuse != reuseCount || seq != seqNodes) {
+        printf("FAIL: %s: reused=%d (expected %d) sequenced=%d (expected %d)\n",
+          step, reuse, reuseCount, seq, seqNodes);
+        failed = 1;
+    }
+}
+
+int main() {
+    FfxSceneConfig config = { .allocFunc = allocFunc, .freeFunc = freeFunc };
+    Scene *scene = ffx_scene_initConfig(&config);
+
+    FfxNode group = ffx_scene_createGroup(scene);
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), group);
+
+    FfxNode boxes[BOX_COUNT];
+    for (int i = 0; i < BOX_COUNT; i++) {
+        boxes[i] = ffx_scene_createBox(scene, ffx_size(4, 4));
+        ffx_sceneBox_setColor(boxes[i], ffx_color_rgb(255, 0, 0));
+        ffx_sceneNode_setPosition(boxes[i], ffx_point(i * 4, 0));
+        ffx_sceneGroup_appendChild(group, boxes[i]);
+    }
+
+    FfxNode sibling = ffx_scene_createBox(scene, ffx_size(10, 10));
+    ffx_sceneBox_setColor(sibling, ffx_color_rgb(0, 255, 0));
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), sibling);
+
+    // Root, group, boxes and sibling
+    ffx_scene_sequence(scene);
+    check(scene, "initial", 0, BOX_COUNT + 3);
+
+    // Only the sibling moves; the group is re-used
+    ffx_sceneNode_setPosition(sibling, ffx_point(20, 20));
+    ffx_scene_sequence(scene);
+    check(scene, "sibling", 1, 2);
+
+    // One box changes; the others are re-used
+    ffx_sceneBox_setColor(boxes[10], ffx_color_rgb(0, 0, 255));
+    ffx_scene_sequence(scene);
+    check(scene, "box", BOX_COUNT, 3);
+
+    // Again, after the box's own renders were re-used
+    ffx_sceneBox_setColor(boxes[20], ffx_color_rgb(0, 0, 255));
+    ffx_scene_sequence(scene);
+    check(scene, "box again", BOX_COUNT, 3);
+
+    // The renders still match the boxes
+    uint16_t fragment[240 * 24];
+    ffx_scene_render(scene, fragment, ffx_point(0, 0), ffx_size(240, 24));
+    for (int i = 0; i < BOX_COUNT; i++) {
+        uint16_t expected = (i == 10 || i == 20) ? 0x001f: 0xf800;
+        if (fragment[i * 4] != expected) {
+            printf("FAIL: box=%d pixel=%04x (expected %04x)\n", i,
+              fragment[i * 4], expected);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "scene.h"
+
+/**
+ *  Stopping, advancing and querying a child only affects its part of an
+ *  animation staggered across its parent's children, and a child's own
+ *  animation retargets the property its staggered action updates.
+ *
+ *  A retargeting animation with a delay holds the property at its
+ *  current value until the delay ends.
+ *
+ *  To run:
+ *    make test
+ */
+
+#define CHILD_COUNT    (5)
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+static int failed = 0;
+
+// Allows for the animation starting on the first sequence (at 1ms) and
+// the interpolation rounding down
+static void checkX(FfxNode node, const char *step, int32_t x) {
+    FfxPoint pos = ffx_sceneNode_getPosition(node);
+    if (pos.x < x - 2 || pos.x > x) {
+        printf("FAIL: %s: x=%d (expected %d)\n", step, pos.x, x);
+        failed = 1;
+    }
+}
+
+static void checkAnimating(FfxNode node, const char *step, uint32_t count) {
+    uint32_t animating = ffx_sceneNode_isAnimating(node);
+    if (animating != count) {
+        printf("FAIL: %s: animating=%d (expected %d)\n", step, animating,
+          count);
+        failed = 1;
+    }
+}
+
+static int completions = 0;
+
+static void onComplete(FfxNode node, FfxSceneActionStop stopType,
+  void *arg) {
+    completions++;
+}
+
+// Each child moves from 0 to 1000 over 1000ms, 100ms after the previous
+static void setupMove(FfxNode node, FfxNodeAnimation *animation, void *arg) {
+    animation->duration = 1000;
+    animation->onComplete = onComplete;
+    ffx_sceneNode_setPosition(node, ffx_point(1000, 0));
+}
+
+static void setupBack(FfxNode node, FfxNodeAnimation *animation, void *arg) {
+    animation->duration = 1000;
+    ffx_sceneNode_setPosition(node, ffx_point(0, 0));
+}
+
+static void setupSlide(FfxNode node, FfxNodeAnimation *animation,
+  void *arg) {
+    animation->duration = 1000;
+    ffx_sceneNode_setPosition(node, ffx_point(1000, 0));
+}
+
+static void setupBackDelayed(FfxNode node, FfxNodeAnimation *animation,
+  void *arg) {
+    animation->delay = 200;
+    animation->duration = 1000;
+    ffx_sceneNode_setPosition(node, ffx_point(0, 0));
+}
+
+int main() {
+    FfxSceneConfig config = { .allocFunc = allocFunc, .freeFunc = freeFunc };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    FfxNode group = ffx_scene_createGroup(scene);
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), group);
+
+    FfxNode children[CHILD_COUNT];
+    for (int i = 0; i < CHILD_COUNT; i++) {
+        children[i] = ffx_scene_createBox(scene, ffx_size(4, 4));
+        ffx_sceneGroup_appendChild(group, children[i]);
+    }
+
+    ffx_scene_sequenceAt(scene, 0);
+
+    ffx_sceneGroup_animateChildren(group, 100, setupMove, NULL);
+    ffx_scene_sequenceAt(scene, 1000);
+
+    checkAnimating(children[4], "staggered child", 1);
+
+    // 400ms in; each child is 100ms behind the previous
+    ffx_scene_sequenceAt(scene, 400000);
+    checkX(children[0], "child 0 at 400ms", 400);
+    checkX(children[3], "child 3 at 400ms", 100);
+
+    ffx_sceneNode_stopAnimations(children[1], false);
+    ffx_sceneNode_stopAnimations(children[2], true);
+    ffx_sceneNode_advanceAnimations(children[3], 500);
+    ffx_scene_sequenceAt(scene, 500000);
+
+    checkX(children[0], "sibling unaffected", 500);
+    checkX(children[1], "stopped", 300);
+    checkX(children[2], "stopped final", 1000);
+    checkX(children[3], "advanced", 700);
+    checkX(children[4], "sibling unaffected", 100);
+
+    checkAnimating(children[1], "stopped", 0);
+    checkAnimating(children[2], "stopped final", 0);
+    checkAnimating(children[3], "advanced", 1);
+    checkAnimating(children[4], "sibling", 1);
+
+    // A child's own animation replaces its staggered action, from 100
+    ffx_sceneNode_animate(children[4], setupBack, NULL);
+    ffx_scene_sequenceAt(scene, 600000);
+    checkAnimating(children[4], "retargeted", 1);
+    ffx_scene_sequenceAt(scene, 700000);
+    checkX(children[4], "retargeted", 90);
+
+    ffx_scene_sequenceAt(scene, 2000000);
+    checkX(children[0], "child 0 done", 1000);
+    checkX(children[3], "child 3 done", 1000);
+    checkX(children[4], "child 4 done", 0);
+
+    // A staggered animation replaces a child's own action
+    ffx_sceneNode_animate(children[0], setupBack, NULL);
+    ffx_scene_sequenceAt(scene, 2100000);
+    ffx_sceneGroup_animateChildren(group, 100, setupBack, NULL);
+    ffx_scene_sequenceAt(scene, 2200000);
+    checkAnimating(children[0], "staggered over own", 1);
+
+    // A delayed animation takes over immediately; the property holds
+    // its current value through the delay
+    FfxNode box = ffx_scene_createBox(scene, ffx_size(4, 4));
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), box);
+    ffx_sceneNode_animate(box, setupSlide, NULL);
+    ffx_scene_sequenceAt(scene, 2300000);
+    ffx_scene_sequenceAt(scene, 2800000);
+    checkX(box, "sliding", 500);
+
+    ffx_sceneNode_animate(box, setupBackDelayed, NULL);
+    ffx_scene_sequenceAt(scene, 2800000);
+    checkAnimating(box, "delayed retarget", 1);
+    ffx_scene_sequenceAt(scene, 2900000);
+    checkX(box, "held in delay", 500);
+    ffx_scene_sequenceAt(scene, 3500000);
+    checkX(box, "after delay", 250);
+
+    if (completions != 1) {
+        printf("FAIL: completions=%d (expected 1)\n", completions);
+        failed = 1;
+    }
+
+    return failed;
+}
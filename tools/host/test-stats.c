@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "scene.h"
+
+/**
+ *  Dumping the stats must not divide by zero after only idle sequences
+ *  or once every render was re-used.
+ *
+ *  To run:
+ *    make test
+ */
+
+static uint8_t* allocFunc(size_t length, void *arg) {
+    return malloc(length);
+}
+
+static void freeFunc(uint8_t *pointer, void *arg) {
+    free(pointer);
+}
+
+// Dump the stats without the noise; a divide by zero traps
+static void dumpStats(FfxScene scene) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    freopen("/dev/null", "w", stdout);
+
+    ffx_scene_dumpStats(scene);
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+int main() {
+    FfxSceneConfig config = { .allocFunc = allocFunc, .freeFunc = freeFunc };
+    FfxScene scene = ffx_scene_initConfig(&config);
+
+    FfxNode box = ffx_scene_createBox(scene, ffx_size(10, 10));
+    ffx_sceneBox_setColor(box, ffx_color_rgb(255, 0, 0));
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), box);
+
+    ffx_scene_sequenceAt(scene, 0);
+    dumpStats(scene);
+
+    // Idle; nothing was sequenced or allocated
+    ffx_scene_sequenceAt(scene, 1000);
+    dumpStats(scene);
+
+    // Sequenced, but the box renders are re-used
+    FfxNode sibling = ffx_scene_createGroup(scene);
+    ffx_sceneGroup_appendChild(ffx_scene_root(scene), sibling);
+    ffx_scene_sequenceAt(scene, 2000);
+    dumpStats(scene);
+
+    return 0;
+}